@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Defined in TaskA.cpp
+void setElement(int* arr, int idx, int val);
+
+// One entry of the TaskA op log: kind is 'u' for sum (a..b) and 'e' for set (a = b).
+// BatchQueries leaves the rest to the caller: 'd' for add (c to a..b), 'a' for assign
+// (c to a..b) and 'v' for sumat (version c, a..b).
+struct BatchOp {
+    char kind;
+    int a = 0;
+    int b = 0;
+    long long c = 0;
+};
+
+// Runs answer(i) for every i in [0, count), split across up to threads threads; epochs
+// smaller than parallelEpochThreshold aren't worth a thread and run on the caller
+constexpr size_t parallelEpochThreshold = 1 << 14;
+
+template<typename Answer>
+void runEpoch(size_t count, unsigned threads, Answer answer) {
+    if (threads <= 1 || count < parallelEpochThreshold) {
+        for (size_t i = 0; i < count; ++i) {
+            answer(i);
+        }
+        return;
+    }
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        size_t stop = std::min(count, begin + chunk);
+        workers.emplace_back([&answer, begin, stop] {
+            for (size_t i = begin; i < stop; ++i) {
+                answer(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Offline evaluator for a whole op log. Runs of consecutive sums form epochs that read
+// a fixed snapshot: prefix sums of arr plus a short sorted list of pending set deltas.
+// Each set boundary folds its writes into the pending list; once that list outgrows
+// ~sqrt(n) entries the prefix array is rebuilt from arr, so a set costs O(sqrt n)
+// amortized while a sum stays O(log sqrt n). Large epochs are split across threads.
+class BatchQueries {
+private:
+    int* arr;
+    int n;
+    unsigned threads;
+    std::vector<long long> prefix;       // prefix[i] = arr[0] + ... + arr[i-1] at last rebuild
+    std::vector<int> pendingIdx;         // indices written since the rebuild, sorted
+    std::vector<long long> pendingDelta; // total change at pendingIdx[k]
+    std::vector<long long> pendingPrefix;
+    size_t pendingLimit;
+
+    void rebuild() {
+        for (int i = 0; i < n; ++i) {
+            prefix[i + 1] = prefix[i] + *(arr + i);
+        }
+        pendingIdx.clear();
+        pendingDelta.clear();
+        pendingPrefix.assign(1, 0);
+    }
+
+    // Applies one set to arr and records its delta against the snapshot
+    void applySet(int idx, int val) {
+        long long delta = (long long)val - *(arr + idx);
+        setElement(arr, idx, val);
+        auto it = std::lower_bound(pendingIdx.begin(), pendingIdx.end(), idx);
+        size_t k = it - pendingIdx.begin();
+        if (it != pendingIdx.end() && *it == idx) {
+            pendingDelta[k] += delta;
+        } else {
+            pendingIdx.insert(it, idx);
+            pendingDelta.insert(pendingDelta.begin() + k, delta);
+        }
+    }
+
+    // Makes the snapshot consistent after a run of sets
+    void closeBoundary() {
+        if (pendingIdx.size() > pendingLimit) {
+            rebuild();
+            return;
+        }
+        pendingPrefix.resize(pendingDelta.size() + 1);
+        for (size_t k = 0; k < pendingDelta.size(); ++k) {
+            pendingPrefix[k + 1] = pendingPrefix[k] + pendingDelta[k];
+        }
+    }
+
+    long long sum(int start, int end) const {
+        size_t lo = std::lower_bound(pendingIdx.begin(), pendingIdx.end(), start) - pendingIdx.begin();
+        size_t hi = std::upper_bound(pendingIdx.begin(), pendingIdx.end(), end) - pendingIdx.begin();
+        return prefix[end + 1] - prefix[start] + pendingPrefix[hi] - pendingPrefix[lo];
+    }
+
+    // Answers ops[first, last) (all sums) into results starting at slot
+    void answerEpoch(const std::vector<BatchOp>& ops, size_t first, size_t last,
+                     std::vector<long long>& results, size_t slot) const {
+        runEpoch(last - first, threads, [&](size_t i) {
+            results[slot + i] = sum(ops[first + i].a, ops[first + i].b);
+        });
+    }
+
+public:
+    BatchQueries(int* arr, int n, unsigned threads)
+        : arr(arr), n(n), threads(threads ? threads : 1), prefix(n + 1, 0),
+          pendingLimit(std::max<size_t>(16, (size_t)std::sqrt((double)n))) {
+        rebuild();
+    }
+
+    // Evaluates the whole log, applying sets to arr; returns the sums in log order
+    std::vector<long long> run(const std::vector<BatchOp>& ops) {
+        std::vector<long long> results;
+        results.resize(std::count_if(ops.begin(), ops.end(), [](const BatchOp& op) { return op.kind == 'u'; }));
+        size_t slot = 0;
+        size_t i = 0;
+        while (i < ops.size()) {
+            if (ops[i].kind == 'u') {
+                size_t last = i;
+                while (last < ops.size() && ops[last].kind == 'u') {
+                    ++last;
+                }
+                answerEpoch(ops, i, last, results, slot);
+                slot += last - i;
+                i = last;
+            } else {
+                while (i < ops.size() && ops[i].kind != 'u') {
+                    if (ops[i].kind == 'e') {
+                        applySet(ops[i].a, ops[i].b);
+                    }
+                    ++i;
+                }
+                closeBoundary();
+            }
+        }
+        return results;
+    }
+};
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "RangeSumBackends.h"
+
+using namespace std;
+
+// Stress test and benchmark: many threads issuing sum and set against one shared array,
+// through ShardedRangeSum and through a Fenwick tree behind a single mutex.
+// Usage: ConcurrencyBench [n] [ops per thread]
+// Prints throughput (million ops/s) for each thread count and read share. Thread t only
+// writes indices i with i % threads == t and only ever raises them, so every sum over a
+// range must be at least the previous sum a thread saw over that range; the sharded runs
+// check that, and check the shard sums against the elements once the threads stop.
+
+long long calculateSum(int* arr, int start, int end) {
+    long long sum = 0;
+    for (int i = start; i <= end; ++i) {
+        sum += *(arr + i);
+    }
+    return sum;
+}
+
+void setElement(int* arr, int idx, int val) {
+    *(arr + idx) = val;
+}
+
+// Baseline: the single-threaded Fenwick tree with every call under one lock
+struct LockedFenwick {
+    vector<int> data;
+    FenwickBackend tree;
+    mutex lock;
+
+    explicit LockedFenwick(vector<int> initial) : data(move(initial)), tree(data.data(), (int)data.size()) {}
+    long long sum(int start, int end) {
+        lock_guard<mutex> guard(lock);
+        return tree.sum(start, end);
+    }
+    int get(int idx) {
+        lock_guard<mutex> guard(lock);
+        return data[idx];
+    }
+    void set(int idx, int val) {
+        lock_guard<mutex> guard(lock);
+        tree.set(idx, val);
+    }
+};
+
+atomic<long long> sink{0};
+
+// Runs the mix on threads threads; returns seconds, and counts monotonicity violations
+template<typename Structure>
+double runMix(Structure& structure, int n, int threads, int opsPerThread, int readPercent, atomic<long long>& violations) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            mt19937 rng(1234 + t);
+            long long checksum = 0;
+            for (int i = 0; i < opsPerThread; ++i) {
+                if ((int)(rng() % 100) < readPercent) {
+                    int lo = rng() % n;
+                    int hi = min(n - 1, lo + (int)(rng() % 8192));
+                    long long first = structure.sum(lo, hi);
+                    long long second = structure.sum(lo, hi);
+                    if (second < first) {
+                        violations.fetch_add(1, memory_order_relaxed);
+                    }
+                    checksum += second;
+                } else {
+                    // Own indices only, so the read-modify-write below can't race
+                    int idx = (int)(rng() % ((n - 1 - t) / threads + 1)) * threads + t;
+                    structure.set(idx, structure.get(idx) + 1 + rng() % 4);
+                }
+            }
+            sink.fetch_add(checksum, memory_order_relaxed); // Keeps the sums from being optimized out
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? stoi(argv[1]) : 1 << 20;
+    int opsPerThread = argc > 2 ? stoi(argv[2]) : 200000;
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    vector<int> threadCounts = {1, 2, 4, 8};
+    if (hardware > 8) {
+        threadCounts.push_back((int)hardware);
+    }
+    const int readPercents[] = {100, 95, 50, 5};
+
+    vector<int> initial(n);
+    mt19937 rng(7);
+    for (int& x : initial) {
+        x = rng() % 1000;
+    }
+
+    cout << "n = " << n << ", " << opsPerThread << " ops per thread, " << hardware << " hardware threads" << endl;
+    cout << "Mops/s: sharded seqlock / one mutex around Fenwick" << endl;
+    cout << setw(8) << "threads";
+    for (int read : readPercents) {
+        cout << setw(20) << (to_string(read) + "% sum");
+    }
+    cout << endl;
+
+    bool ok = true;
+    for (int threads : threadCounts) {
+        cout << setw(8) << threads;
+        for (int read : readPercents) {
+            atomic<long long> violations{0};
+            ShardedRangeSum sharded(initial.data(), n);
+            double shardedSeconds = runMix(sharded, n, threads, opsPerThread, read, violations);
+            LockedFenwick locked(initial);
+            atomic<long long> ignored{0};
+            double lockedSeconds = runMix(locked, n, threads, opsPerThread, read, ignored);
+
+            if (violations > 0 || !sharded.consistent()) {
+                ok = false;
+            }
+            double ops = double(threads) * opsPerThread / 1e6;
+            ostringstream cell;
+            cell << fixed << setprecision(1) << ops / shardedSeconds << " / " << ops / lockedSeconds;
+            cout << setw(20) << cell.str();
+        }
+        cout << endl;
+    }
+    cout << (ok ? "checks passed" : "CHECK FAILED: non-monotonic sum or inconsistent shard") << endl;
+    return ok ? 0 : 1;
+}
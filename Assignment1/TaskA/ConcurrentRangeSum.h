@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Thread-safe sum/set over a fixed-size array, for many client threads sharing one array.
+// The array is cut into shards of shardSize elements that start on a cache line; each shard
+// has its own cache line holding a seqlock sequence and the shard's precomputed sum, and
+// every cache line of elements has a sum too, so a range costs O(range / shardSize + 64).
+// set takes the seqlock of one shard (writers to different shards never contend); sum takes
+// no lock: it reads optimistically and retries if a writer touched any shard it read.
+class ShardedRangeSum {
+public:
+    static constexpr int shardSize = 1024; // Elements per shard: 64 cache lines
+
+private:
+    struct alignas(64) CacheLine {
+        std::atomic<int> values[16];
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> sequence{0}; // Odd while a writer is inside the shard
+        std::atomic<long long> sum{0};
+    };
+
+    int n;
+    std::vector<CacheLine> lines;
+    std::vector<std::atomic<long long>> lineSums; // Sum of each cache line of elements
+    std::vector<Shard> shards;
+
+    const std::atomic<int>& element(int i) const { return lines[i >> 4].values[i & 15]; }
+    std::atomic<int>& element(int i) { return lines[i >> 4].values[i & 15]; }
+
+    static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Sum of [lo, hi] within one shard: whole cache lines through their sums, the rest elementwise
+    long long partialSum(int lo, int hi) const {
+        long long total = 0;
+        int i = lo;
+        for (; i <= hi && (i & 15); ++i) {
+            total += element(i).load(std::memory_order_relaxed);
+        }
+        for (; i + 15 <= hi; i += 16) {
+            total += lineSums[i >> 4].load(std::memory_order_relaxed);
+        }
+        for (; i <= hi; ++i) {
+            total += element(i).load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Shard's sequence once no writer is inside it
+    static uint64_t readBegin(const Shard& shard) {
+        uint64_t sequence;
+        while ((sequence = shard.sequence.load(std::memory_order_acquire)) & 1) {
+            pause();
+        }
+        return sequence;
+    }
+
+public:
+    ShardedRangeSum(const int* arr, int n)
+        : n(n), lines((n + 15) / 16), lineSums((n + 15) / 16), shards((n + shardSize - 1) / shardSize) {
+        for (int i = 0; i < n; ++i) {
+            element(i).store(arr[i], std::memory_order_relaxed);
+            lineSums[i >> 4].fetch_add(arr[i], std::memory_order_relaxed);
+            shards[i / shardSize].sum.fetch_add(arr[i], std::memory_order_relaxed);
+        }
+    }
+
+    int size() const { return n; }
+
+    int get(int idx) const {
+        return element(idx).load(std::memory_order_relaxed);
+    }
+
+    // Sum of [start, end]. Whole shards contribute their stored sum, the two edge shards
+    // their line sums and elements. Sequences only grow, so the read is clean exactly when the total of the
+    // sequences seen before the reads equals the total seen after them; the result is then
+    // the range's value at one instant (the last shard's first read).
+    long long sum(int start, int end) const {
+        int first = start / shardSize;
+        int last = end / shardSize;
+        for (;;) {
+            uint64_t before = 0;
+            long long total = 0;
+            for (int k = first; k <= last; ++k) {
+                before += readBegin(shards[k]);
+                int shardBegin = k * shardSize;
+                int shardEnd = std::min(n, shardBegin + shardSize) - 1;
+                int lo = std::max(start, shardBegin);
+                int hi = std::min(end, shardEnd);
+                if (lo == shardBegin && hi == shardEnd) {
+                    total += shards[k].sum.load(std::memory_order_relaxed);
+                } else {
+                    total += partialSum(lo, hi);
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t after = 0;
+            for (int k = first; k <= last; ++k) {
+                after += shards[k].sequence.load(std::memory_order_relaxed);
+            }
+            if (after == before) {
+                return total;
+            }
+        }
+    }
+
+    void set(int idx, int val) {
+        Shard& shard = shards[idx / shardSize];
+        uint64_t sequence = shard.sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if (sequence & 1) {
+                pause();
+                sequence = shard.sequence.load(std::memory_order_relaxed);
+            } else if (shard.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+                                                            std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        // Readers that see any of the stores below also see the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<int>& slot = element(idx);
+        long long delta = (long long)val - slot.load(std::memory_order_relaxed);
+        slot.store(val, std::memory_order_relaxed);
+        std::atomic<long long>& line = lineSums[idx >> 4];
+        line.store(line.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        shard.sum.store(shard.sum.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        shard.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Whether every stored line and shard sum matches its elements; for checks after the writers stop
+    bool consistent() const {
+        for (int line = 0; line < (int)lineSums.size(); ++line) {
+            long long total = 0;
+            for (int i = line * 16; i < std::min(n, line * 16 + 16); ++i) {
+                total += get(i);
+            }
+            if (total != lineSums[line].load(std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+        for (int k = 0; k < (int)shards.size(); ++k) {
+            long long total = 0;
+            for (int i = k * shardSize; i < std::min(n, (k + 1) * shardSize); ++i) {
+                total += get(i);
+            }
+            if (total != shards[k].sum.load(std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
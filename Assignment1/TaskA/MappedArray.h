@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_ARRAY_POSIX 1
+#endif
+
+// Defined in TaskA.cpp
+long long calculateSum(int* arr, int start, int end);
+
+// On-disk TaskA array for datasets larger than RAM. Two files:
+//   <path>      64-byte header ("TAARRAY1", n, block size) followed by the n ints
+//   <path>.idx  64-byte header ("TAINDEX1", n, block size, block count) followed by a
+//               Fenwick tree over the block sums (1-based int64s)
+// Both are mapped shared, so opening costs O(1) and set writes straight back to the file's
+// pages; the kernel decides what stays resident. A sum reads O(log blocks) index entries
+// plus at most two partial blocks.
+class MappedArray {
+private:
+    static constexpr size_t headerSize = 64;
+
+    struct Header {
+        char magic[8];
+        uint64_t n;
+        uint64_t blockSize;
+        uint64_t blocks; // Index header only
+    };
+
+    int* data = nullptr;
+    long long* tree = nullptr; // tree[i] covers blocks (i - lowbit(i), i], 1-based
+    long long n = 0;
+    long long blockSize = 0;
+    long long blocks = 0;
+    void* dataMap = nullptr;
+    size_t dataBytes = 0;
+    void* indexMap = nullptr;
+    size_t indexBytes = 0;
+
+    long long blockPrefix(long long count) const {
+        long long sum = 0;
+        for (long long i = count; i > 0; i -= i & -i) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    void blockAdd(long long block, long long delta) {
+        for (long long i = block + 1; i <= blocks; i += i & -i) {
+            tree[i] += delta;
+        }
+    }
+
+    // Sum of [start, end] inside one block
+    long long scan(long long start, long long end) const {
+        long long base = start / blockSize * blockSize;
+        return calculateSum(data + base, (int)(start - base), (int)(end - base));
+    }
+
+#ifdef MAPPED_ARRAY_POSIX
+    // Maps path read-write; returns nullptr and sets error on failure
+    static void* mapFile(const std::string& path, size_t& bytes, std::string& error) {
+        int fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            error = "Error: Unable to open " + path + ".";
+            return nullptr;
+        }
+        struct stat st {};
+        void* p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= headerSize) {
+            bytes = st.st_size;
+            p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd); // The mapping keeps the file open
+        if (p == MAP_FAILED) {
+            error = "Error: Unable to map " + path + ".";
+            return nullptr;
+        }
+        return p;
+    }
+#endif
+
+public:
+    MappedArray() = default;
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    ~MappedArray() {
+#ifdef MAPPED_ARRAY_POSIX
+        if (dataMap) munmap(dataMap, dataBytes);
+        if (indexMap) munmap(indexMap, indexBytes);
+#endif
+    }
+
+    // Writes n values, each taken from next(), and their block index as a mapped array at
+    // path. Values go to the file through a fixed-size buffer while the block sums build up,
+    // so only the index (one int64 per block) is ever held in memory.
+    template<typename Next>
+    static bool create(const std::string& path, long long n, long long blockSize, Next next, std::string& error) {
+        static constexpr size_t chunkSize = 1 << 16;
+        long long blocks = (n + blockSize - 1) / blockSize;
+        std::vector<long long> index(blocks + 1, 0);
+
+        char header[headerSize] = {};
+        Header fields{{'T', 'A', 'A', 'R', 'R', 'A', 'Y', '1'}, (uint64_t)n, (uint64_t)blockSize, 0};
+        std::memcpy(header, &fields, sizeof fields);
+        FILE* file = std::fopen(path.c_str(), "wb");
+        bool ok = file && std::fwrite(header, 1, headerSize, file) == headerSize;
+        std::vector<int> chunk;
+        chunk.reserve(chunkSize);
+        for (long long i = 0; ok && i < n; ++i) {
+            int val = next();
+            index[i / blockSize + 1] += val;
+            chunk.push_back(val);
+            if (chunk.size() == chunkSize || i == n - 1) {
+                ok = std::fwrite(chunk.data(), sizeof(int), chunk.size(), file) == chunk.size();
+                chunk.clear();
+            }
+        }
+        if (file) std::fclose(file);
+
+        for (long long i = 1; i <= blocks; ++i) { // Linear-time Fenwick build
+            long long parent = i + (i & -i);
+            if (parent <= blocks) {
+                index[parent] += index[i];
+            }
+        }
+        Header indexFields{{'T', 'A', 'I', 'N', 'D', 'E', 'X', '1'}, (uint64_t)n, (uint64_t)blockSize, (uint64_t)blocks};
+        std::memcpy(header, &indexFields, sizeof indexFields);
+        file = ok ? std::fopen((path + ".idx").c_str(), "wb") : nullptr;
+        ok = file && std::fwrite(header, 1, headerSize, file) == headerSize &&
+             std::fwrite(index.data(), sizeof(long long), index.size(), file) == index.size();
+        if (file) std::fclose(file);
+        if (!ok) {
+            error = "Error: Unable to write " + path + ".";
+        }
+        return ok;
+    }
+
+    // Maps the array at path and its index; checks that the two agree
+    bool open(const std::string& path, std::string& error) {
+#ifdef MAPPED_ARRAY_POSIX
+        dataMap = mapFile(path, dataBytes, error);
+        indexMap = dataMap ? mapFile(path + ".idx", indexBytes, error) : nullptr;
+        if (!indexMap) {
+            return false;
+        }
+        Header dataHeader, indexHeader;
+        std::memcpy(&dataHeader, dataMap, sizeof dataHeader);
+        std::memcpy(&indexHeader, indexMap, sizeof indexHeader);
+        n = dataHeader.n;
+        blockSize = dataHeader.blockSize;
+        blocks = indexHeader.blocks;
+        // The counts come from the file, so they are bounded by the mapped bytes before any
+        // arithmetic on them; the block index holds blocks + 1 entries
+        bool valid = std::memcmp(dataHeader.magic, "TAARRAY1", 8) == 0 && std::memcmp(indexHeader.magic, "TAINDEX1", 8) == 0 &&
+                     indexHeader.n == dataHeader.n && indexHeader.blockSize == dataHeader.blockSize &&
+                     n >= 0 && (size_t)n <= (dataBytes - headerSize) / sizeof(int) &&
+                     blocks >= 0 && (size_t)blocks < (indexBytes - headerSize) / sizeof(long long) &&
+                     blockSize > 0 && blocks == n / blockSize + (n % blockSize != 0);
+        if (!valid) {
+            error = "Error: " + path + " is not a mapped TaskA array with a matching index.";
+            return false;
+        }
+        data = reinterpret_cast<int*>(static_cast<char*>(dataMap) + headerSize);
+        tree = reinterpret_cast<long long*>(static_cast<char*>(indexMap) + headerSize);
+        madvise(dataMap, dataBytes, MADV_RANDOM); // Ops jump around; read-ahead would only fill RAM
+        return true;
+#else
+        error = "Error: Mapped arrays need a POSIX system.";
+        return false;
+#endif
+    }
+
+    long long size() const { return n; }
+
+    int get(long long idx) const { return *(data + idx); }
+
+    long long sum(long long start, long long end) const {
+        long long first = start / blockSize;
+        long long last = end / blockSize;
+        if (first == last) {
+            return scan(start, end);
+        }
+        return scan(start, (first + 1) * blockSize - 1) + blockPrefix(last) - blockPrefix(first + 1) +
+               scan(last * blockSize, end);
+    }
+
+    void set(long long idx, int val) {
+        blockAdd(idx / blockSize, (long long)val - *(data + idx));
+        *(data + idx) = val;
+    }
+
+    // Schedules the dirty pages of both files for write-back
+    void flush() {
+#ifdef MAPPED_ARRAY_POSIX
+        if (dataMap) msync(dataMap, dataBytes, MS_ASYNC);
+        if (indexMap) msync(indexMap, indexBytes, MS_ASYNC);
+#endif
+    }
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Versioned range sums: version v is the array after the first v updates (version 0 is the
+// input array). Updates copy only the nodes they visit, at most 4 per tree level: a range
+// add or assign stops at the nodes its range covers and leaves a lazy tag there instead of
+// rewriting the leaves, so a set, add or assign costs O(log n) nodes. Tags are never pushed
+// into shared children in place; an update that passes through a tagged node hands the tag
+// down to the children's copies, and a query composes the tags on its path.
+// With a history limit of K, only the latest K versions stay queryable. Once the node pool
+// reaches twice what survived the last compaction (and four times the initial tree), the
+// nodes reachable from those versions are copied into a fresh pool, so memory stays within
+// about 2 * (2n + 4K log n) nodes.
+class PersistentSegmentTree {
+private:
+    // Pending update of every element below a node: x becomes (assigned ? value : x) + add
+    struct Tag {
+        bool assigned = false;
+        long long value = 0;
+        long long add = 0;
+
+        bool empty() const { return !assigned && add == 0; }
+    };
+
+    struct Node {
+        long long sum; // Includes the node's own tag
+        int left;      // -1 for leaves
+        int right;
+        Tag tag;       // Not yet applied to the children
+    };
+
+    int n;
+    size_t history;             // Versions kept queryable, 0 for all of them
+    std::vector<Node> nodes;
+    std::vector<int> roots;     // roots[v - firstStored] is the root of version v
+    long long firstStored = 0;  // Oldest version that still has a root
+    long long current = 0;
+    size_t compactAt;
+
+    // outer applied after inner
+    static Tag compose(const Tag& outer, const Tag& inner) {
+        if (outer.assigned) {
+            return outer;
+        }
+        return {inner.assigned, inner.value, inner.add + outer.add};
+    }
+
+    // Sum of count elements with total sum after tag
+    static long long applied(long long sum, long long count, const Tag& tag) {
+        return (tag.assigned ? tag.value * count : sum) + tag.add * count;
+    }
+
+    int build(const int* arr, int lo, int hi) {
+        if (lo == hi) {
+            nodes.push_back({*(arr + lo), -1, -1, {}});
+            return (int)nodes.size() - 1;
+        }
+        int mid = lo + (hi - lo) / 2;
+        int left = build(arr, lo, mid);
+        int right = build(arr, mid + 1, hi);
+        nodes.push_back({nodes[left].sum + nodes[right].sum, left, right, {}});
+        return (int)nodes.size() - 1;
+    }
+
+    // Copy of node (covering count elements) with tag applied on top of it
+    int withTag(int node, long long count, const Tag& tag) {
+        Node copy = nodes[node];
+        copy.sum = applied(copy.sum, count, tag);
+        copy.tag = copy.left >= 0 ? compose(tag, copy.tag) : Tag{};
+        nodes.push_back(copy);
+        return (int)nodes.size() - 1;
+    }
+
+    // Copy of node's subtree with pending (its parent's tag) applied everywhere and then
+    // change applied to [start, end]; untouched subtrees are shared when nothing is pending
+    int update(int node, int lo, int hi, int start, int end, const Tag& change, const Tag& pending) {
+        if (end < lo || hi < start) {
+            return pending.empty() ? node : withTag(node, hi - lo + 1, pending);
+        }
+        if (start <= lo && hi <= end) {
+            return withTag(node, hi - lo + 1, compose(change, pending));
+        }
+        int mid = lo + (hi - lo) / 2;
+        Node parent = nodes[node];
+        Tag down = compose(pending, parent.tag);
+        int left = update(parent.left, lo, mid, start, end, change, down);
+        int right = update(parent.right, mid + 1, hi, start, end, change, down);
+        nodes.push_back({nodes[left].sum + nodes[right].sum, left, right, {}});
+        return (int)nodes.size() - 1;
+    }
+
+    void pushRange(int start, int end, const Tag& tag) {
+        if (n == 0) { // No elements and no roots: the update only counts as a version
+            ++current;
+            return;
+        }
+        pushVersion(update(roots.back(), 0, n - 1, start, end, tag, Tag{}));
+    }
+
+    void pushVersion(int root) {
+        roots.push_back(root);
+        ++current;
+        if (history > 0 && nodes.size() > compactAt) {
+            compact();
+        }
+    }
+
+    // Sum of [start, end] within node, with pending (the composed tags above it) applied
+    long long query(int node, int lo, int hi, int start, int end, const Tag& pending) const {
+        if (start <= lo && hi <= end) {
+            return applied(nodes[node].sum, hi - lo + 1, pending);
+        }
+        int mid = lo + (hi - lo) / 2;
+        Tag down = compose(pending, nodes[node].tag);
+        long long sum = 0;
+        if (start <= mid) {
+            sum += query(nodes[node].left, lo, mid, start, end, down);
+        }
+        if (end > mid) {
+            sum += query(nodes[node].right, mid + 1, hi, start, end, down);
+        }
+        return sum;
+    }
+
+    // Moves node's subtree into pool (once per node, tracked by moved); returns its new index
+    int copyInto(std::vector<Node>& pool, std::vector<int>& moved, int node) const {
+        if (moved[node] >= 0) {
+            return moved[node];
+        }
+        Node copy = nodes[node];
+        if (copy.left >= 0) {
+            copy.left = copyInto(pool, moved, copy.left);
+            copy.right = copyInto(pool, moved, copy.right);
+        }
+        pool.push_back(copy);
+        return moved[node] = (int)pool.size() - 1;
+    }
+
+    // Drops the versions outside the history window and every node only they reached
+    void compact() {
+        long long keepFrom = oldestVersion();
+        roots.erase(roots.begin(), roots.begin() + (keepFrom - firstStored));
+        firstStored = keepFrom;
+        std::vector<Node> pool;
+        std::vector<int> moved(nodes.size(), -1);
+        for (int& root : roots) {
+            root = copyInto(pool, moved, root);
+        }
+        nodes.swap(pool);
+        compactAt = std::max<size_t>(compactAt, 2 * nodes.size());
+    }
+
+public:
+    // An empty array gets no tree: updates only advance the version and every sum is 0
+    PersistentSegmentTree(const int* arr, int n, size_t history) : n(n), history(history) {
+        nodes.reserve(2 * n);
+        if (n > 0) {
+            roots.push_back(build(arr, 0, n - 1));
+        }
+        compactAt = 4 * nodes.size();
+    }
+
+    // Records a new version with idx set to val
+    void set(int idx, int val) {
+        pushRange(idx, idx, {true, val, 0});
+    }
+
+    // Records a new version with val added to, or assigned to, every element of [start, end]
+    void add(int start, int end, int val) {
+        pushRange(start, end, {false, 0, val});
+    }
+
+    void assign(int start, int end, int val) {
+        pushRange(start, end, {true, val, 0});
+    }
+
+    long long latestVersion() const { return current; }
+
+    long long oldestVersion() const {
+        return history > 0 ? std::max(0LL, current - (long long)history + 1) : 0;
+    }
+
+    bool retained(long long version) const {
+        return version >= oldestVersion() && version <= current;
+    }
+
+    // Sum of [start, end] as of a retained version
+    long long sumAt(long long version, int start, int end) const {
+        return n > 0 ? query(roots[version - firstStored], 0, n - 1, start, end, Tag{}) : 0;
+    }
+
+    size_t nodeCount() const { return nodes.size(); }
+};
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ConcurrentRangeSum.h"
+
+// Defined in TaskA.cpp: the reference linear scan and the raw element update
+long long calculateSum(int* arr, int start, int end);
+void setElement(int* arr, int idx, int val);
+
+// Interface for the structures answering the sum/set/add/assign command stream over arr
+class RangeSumBackend {
+public:
+    virtual long long sum(int start, int end) = 0;
+    virtual void set(int idx, int val) = 0;
+
+    // Range updates; by default one set per element, reading each through sum
+    virtual void add(int start, int end, int val) {
+        for (int i = start; i <= end; ++i) {
+            set(i, (int)(sum(i, i) + val));
+        }
+    }
+
+    virtual void assign(int start, int end, int val) {
+        for (int i = start; i <= end; ++i) {
+            set(i, val);
+        }
+    }
+
+    // Writes deferred updates through to arr, before it is printed
+    virtual void sync() {}
+
+    virtual ~RangeSumBackend() {} // Virtual destructor
+};
+
+// Reference backend: every sum walks the range with calculateSum
+class LinearBackend : public RangeSumBackend {
+private:
+    int* arr;
+
+public:
+    explicit LinearBackend(int* arr) : arr(arr) {}
+
+    long long sum(int start, int end) override {
+        return calculateSum(arr, start, end);
+    }
+
+    void set(int idx, int val) override {
+        setElement(arr, idx, val);
+    }
+};
+
+// Fenwick (binary indexed) tree: O(log n) prefix sums and point updates
+class FenwickBackend : public RangeSumBackend {
+private:
+    int* arr;
+    std::vector<long long> tree; // 1-based, tree[i] covers (i - lowbit(i), i]
+
+    long long prefix(int count) const {
+        long long sum = 0;
+        for (int i = count; i > 0; i -= i & -i) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    void addAt(int idx, long long delta) {
+        for (int i = idx + 1; i < (int)tree.size(); i += i & -i) {
+            tree[i] += delta;
+        }
+    }
+
+public:
+    FenwickBackend(int* arr, int n) : arr(arr), tree(n + 1, 0) {
+        // Linear-time build: push each node's total into its parent
+        for (int i = 1; i <= n; ++i) {
+            tree[i] += *(arr + i - 1);
+            int parent = i + (i & -i);
+            if (parent <= n) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
+
+    long long sum(int start, int end) override {
+        return prefix(end + 1) - prefix(start);
+    }
+
+    void set(int idx, int val) override {
+        addAt(idx, (long long)val - *(arr + idx));
+        setElement(arr, idx, val);
+    }
+};
+
+// Iterative bottom-up segment tree: leaves at [n, 2n), node i = 2i + 2i+1
+class SegmentTreeBackend : public RangeSumBackend {
+private:
+    int* arr;
+    int n;
+    std::vector<long long> tree;
+
+public:
+    SegmentTreeBackend(int* arr, int n) : arr(arr), n(n), tree(2 * n, 0) {
+        for (int i = 0; i < n; ++i) {
+            tree[n + i] = *(arr + i);
+        }
+        for (int i = n - 1; i > 0; --i) {
+            tree[i] = tree[2 * i] + tree[2 * i + 1];
+        }
+    }
+
+    long long sum(int start, int end) override {
+        long long sum = 0;
+        for (int l = start + n, r = end + n + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) sum += tree[l++];
+            if (r & 1) sum += tree[--r];
+        }
+        return sum;
+    }
+
+    void set(int idx, int val) override {
+        setElement(arr, idx, val);
+        int i = idx + n;
+        tree[i] = val;
+        for (i >>= 1; i > 0; i >>= 1) {
+            tree[i] = tree[2 * i] + tree[2 * i + 1];
+        }
+    }
+};
+
+// Segment tree with lazy propagation: add and assign tag the O(log n) nodes covering the
+// range instead of touching every element, and pending tags are pushed one level down only
+// when a later op descends through them. arr itself is only brought up to date by sync().
+class LazySegmentTreeBackend : public RangeSumBackend {
+private:
+    int* arr;
+    int n;
+    std::vector<long long> sums;    // Node 1 is the root, node i has children 2i and 2i + 1
+    std::vector<long long> pendingAdd;
+    std::vector<long long> pendingAssign;
+    std::vector<char> assigned;     // Whether pendingAssign is set; applies before pendingAdd
+
+    void build(int node, int lo, int hi) {
+        if (lo == hi) {
+            sums[node] = *(arr + lo);
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        build(2 * node, lo, mid);
+        build(2 * node + 1, mid + 1, hi);
+        sums[node] = sums[2 * node] + sums[2 * node + 1];
+    }
+
+    void applyAssign(int node, int length, long long val) {
+        sums[node] = val * length;
+        pendingAssign[node] = val;
+        assigned[node] = 1;
+        pendingAdd[node] = 0;
+    }
+
+    void applyAdd(int node, int length, long long val) {
+        sums[node] += val * length;
+        pendingAdd[node] += val;
+    }
+
+    void pushDown(int node, int lo, int mid, int hi) {
+        if (assigned[node]) {
+            applyAssign(2 * node, mid - lo + 1, pendingAssign[node]);
+            applyAssign(2 * node + 1, hi - mid, pendingAssign[node]);
+            assigned[node] = 0;
+        }
+        if (pendingAdd[node]) {
+            applyAdd(2 * node, mid - lo + 1, pendingAdd[node]);
+            applyAdd(2 * node + 1, hi - mid, pendingAdd[node]);
+            pendingAdd[node] = 0;
+        }
+    }
+
+    // Assigns val to [start, end] when isAssign, adds it otherwise
+    void update(int node, int lo, int hi, int start, int end, long long val, bool isAssign) {
+        if (end < lo || hi < start) {
+            return;
+        }
+        if (start <= lo && hi <= end) {
+            if (isAssign) {
+                applyAssign(node, hi - lo + 1, val);
+            } else {
+                applyAdd(node, hi - lo + 1, val);
+            }
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        pushDown(node, lo, mid, hi);
+        update(2 * node, lo, mid, start, end, val, isAssign);
+        update(2 * node + 1, mid + 1, hi, start, end, val, isAssign);
+        sums[node] = sums[2 * node] + sums[2 * node + 1];
+    }
+
+    long long query(int node, int lo, int hi, int start, int end) {
+        if (end < lo || hi < start) {
+            return 0;
+        }
+        if (start <= lo && hi <= end) {
+            return sums[node];
+        }
+        int mid = lo + (hi - lo) / 2;
+        pushDown(node, lo, mid, hi);
+        return query(2 * node, lo, mid, start, end) + query(2 * node + 1, mid + 1, hi, start, end);
+    }
+
+    // Same as query but leaves the tree untouched: tags still pending above a node are carried
+    // down instead of pushed (an outer assign overrides what is below it, adds accumulate)
+    long long peek(int node, int lo, int hi, int start, int end,
+                   bool carryAssigned, long long carryAssign, long long carryAdd) const {
+        if (end < lo || hi < start) {
+            return 0;
+        }
+        long long length = hi - lo + 1;
+        if (start <= lo && hi <= end) {
+            return (carryAssigned ? carryAssign * length : sums[node]) + carryAdd * length;
+        }
+        if (!carryAssigned) {
+            carryAssigned = assigned[node];
+            carryAssign = pendingAssign[node];
+            carryAdd += pendingAdd[node];
+        }
+        int mid = lo + (hi - lo) / 2;
+        return peek(2 * node, lo, mid, start, end, carryAssigned, carryAssign, carryAdd) +
+               peek(2 * node + 1, mid + 1, hi, start, end, carryAssigned, carryAssign, carryAdd);
+    }
+
+    // Pushes every pending tag down to the leaves and copies them into arr
+    void flush(int node, int lo, int hi) {
+        if (lo == hi) {
+            setElement(arr, lo, (int)sums[node]);
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        pushDown(node, lo, mid, hi);
+        flush(2 * node, lo, mid);
+        flush(2 * node + 1, mid + 1, hi);
+    }
+
+public:
+    // An empty array has no root, so every op below is a no-op for n == 0
+    LazySegmentTreeBackend(int* arr, int n)
+        : arr(arr), n(n), sums(4 * n, 0), pendingAdd(4 * n, 0), pendingAssign(4 * n, 0), assigned(4 * n, 0) {
+        if (n > 0) {
+            build(1, 0, n - 1);
+        }
+    }
+
+    long long sum(int start, int end) override {
+        return n > 0 ? query(1, 0, n - 1, start, end) : 0;
+    }
+
+    // Read-only sum, safe to call from several threads while no update runs
+    long long peekSum(int start, int end) const {
+        return n > 0 ? peek(1, 0, n - 1, start, end, false, 0, 0) : 0;
+    }
+
+    void set(int idx, int val) override {
+        if (n > 0) {
+            update(1, 0, n - 1, idx, idx, val, true);
+        }
+    }
+
+    void add(int start, int end, int val) override {
+        if (n > 0) {
+            update(1, 0, n - 1, start, end, val, false);
+        }
+    }
+
+    void assign(int start, int end, int val) override {
+        if (n > 0) {
+            update(1, 0, n - 1, start, end, val, true);
+        }
+    }
+
+    void sync() override {
+        if (n > 0) {
+            flush(1, 0, n - 1);
+        }
+    }
+};
+
+// The thread-safe ShardedRangeSum behind the single-stream interface; arr is kept in sync
+class ShardedBackend : public RangeSumBackend {
+private:
+    int* arr;
+    ShardedRangeSum shards;
+
+public:
+    ShardedBackend(int* arr, int n) : arr(arr), shards(arr, n) {}
+
+    long long sum(int start, int end) override {
+        return shards.sum(start, end);
+    }
+
+    void set(int idx, int val) override {
+        shards.set(idx, val);
+        setElement(arr, idx, val);
+    }
+};
+
+// Factory for the --backend=<name> startup flag; returns nullptr for unknown names
+inline std::unique_ptr<RangeSumBackend> makeBackend(const std::string& name, int* arr, int n) {
+    if (name == "linear") {
+        return std::make_unique<LinearBackend>(arr);
+    } else if (name == "fenwick") {
+        return std::make_unique<FenwickBackend>(arr, n);
+    } else if (name == "segment") {
+        return std::make_unique<SegmentTreeBackend>(arr, n);
+    } else if (name == "lazy") {
+        return std::make_unique<LazySegmentTreeBackend>(arr, n);
+    } else if (name == "sharded") {
+        return std::make_unique<ShardedBackend>(arr, n);
+    }
+    return nullptr;
+}
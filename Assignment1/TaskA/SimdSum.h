@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define TASKA_X86_KERNELS 1
+#endif
+
+// Signature shared by all range-sum kernels: sum of count ints starting at arr
+using SumKernel = long long (*)(const int* arr, int count);
+
+// Portable kernel: plain pointer walk with a 64-bit accumulator
+inline long long sumScalar(const int* arr, int count) {
+    long long sum = 0;
+    for (const int* p = arr; p != arr + count; ++p) {
+        sum += *p;
+    }
+    return sum;
+}
+
+#ifdef TASKA_X86_KERNELS
+
+// SSE4.1 kernel: widens 2 ints per step to int64 lanes, so lanes never overflow
+__attribute__((target("sse4.1")))
+inline long long sumSse41(const int* arr, int count) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i));
+        acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(v));
+        acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    __m128i acc = _mm_add_epi64(acc0, acc1);
+    long long sum = _mm_cvtsi128_si64(acc) + _mm_extract_epi64(acc, 1);
+    return sum + sumScalar(arr + i, count - i);
+}
+
+// AVX2 kernel: 8 ints per step into two 4 x int64 accumulators
+__attribute__((target("avx2")))
+inline long long sumAvx2(const int* arr, int count) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i + 4));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(lo));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(hi));
+    }
+    __m256i acc = _mm256_add_epi64(acc0, acc1);
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    long long sum = _mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1);
+    return sum + sumScalar(arr + i, count - i);
+}
+
+#endif
+
+// Picks a kernel by name ("auto" probes the CPU); returns nullptr if unknown or unsupported
+inline SumKernel selectSumKernel(const std::string& name) {
+    if (name == "scalar") {
+        return sumScalar;
+    }
+#ifdef TASKA_X86_KERNELS
+    __builtin_cpu_init();
+    bool hasAvx2 = __builtin_cpu_supports("avx2");
+    bool hasSse41 = __builtin_cpu_supports("sse4.1");
+    if (name == "avx2") {
+        return hasAvx2 ? sumAvx2 : nullptr;
+    } else if (name == "sse") {
+        return hasSse41 ? sumSse41 : nullptr;
+    } else if (name == "auto") {
+        return hasAvx2 ? sumAvx2 : hasSse41 ? sumSse41 : sumScalar;
+    }
+#else
+    if (name == "auto") {
+        return sumScalar;
+    }
+#endif
+    return nullptr;
+}
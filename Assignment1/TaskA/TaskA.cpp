@@ -1,16 +1,25 @@
 #include <iostream>
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <memory>
+#include <thread>
+#include "RangeSumBackends.h"
+#include "SimdSum.h"
+#include "BatchQueries.h"
+#include "PersistentSegmentTree.h"
+#include "MappedArray.h"
+#include "../../Common/FastInput.h"
+#include "../../Common/FastOutput.h"
 
 using namespace std;
 
+// Range-sum kernel used by calculateSum, picked once at startup
+static SumKernel sumKernel = sumScalar;
+
 // Function to calculate the sum of elements within a specified range
-int calculateSum(int* arr, int start, int end) {
-    int sum = 0;
-    for (int i = start; i <= end; ++i) {
-        sum += *(arr + i);
-    }
-    return sum;
+long long calculateSum(int* arr, int start, int end) {
+    return sumKernel(arr + start, end - start + 1);
 }
 
 // Function to set an element of the array using a pointer
@@ -18,40 +27,308 @@ void setElement(int* arr, int idx, int val) {
     *(arr + idx) = val;
 }
 
-int main() {
-    int n, m;
-    cin >> n >> m;
+// Op kind: 'u' is "sum", 'e' is "set", 'd' is "add", 'a' is "assign", 'v' is "sumat";
+// any other token is unknown ('\0')
+char opKind(string_view op) {
+    if (op == "sum") {
+        return 'u';
+    }
+    if (op == "set") {
+        return 'e';
+    }
+    if (op == "add") {
+        return 'd';
+    }
+    return op == "assign" ? 'a' : op == "sumat" ? 'v' : '\0';
+}
+
+// Reads one op and its operands; unknown ops read nothing more
+BatchOp readOp(FastInput& in) {
+    BatchOp op{opKind(in.readToken())};
+    switch (op.kind) {
+        case 'v':
+            op.c = in.readLong();
+            op.a = in.readInt();
+            op.b = in.readInt();
+            break;
+        case 'u':
+        case 'e':
+            op.a = in.readInt();
+            op.b = in.readInt();
+            break;
+        case 'd':
+        case 'a':
+            op.a = in.readInt();
+            op.b = in.readInt();
+            op.c = in.readInt();
+            break;
+    }
+    return op;
+}
+
+// Reads the m ops of the log
+vector<BatchOp> readOps(FastInput& in, int m) {
+    vector<BatchOp> ops(m);
+    for (int i = 0; i < m; ++i) {
+        ops[i] = readOp(in);
+    }
+    return ops;
+}
+
+// Whether any op in the log has one of the given kinds
+bool hasOp(const vector<BatchOp>& ops, string_view kinds) {
+    return any_of(ops.begin(), ops.end(),
+                  [kinds](const BatchOp& op) { return kinds.find(op.kind) != string_view::npos; });
+}
+
+// Answers "sumat version start end" from the version history, or says the version is gone
+void answerSumAt(FastOutput& out, const PersistentSegmentTree& versions, long long version, int start, int end) {
+    if (versions.retained(version)) {
+        out << versions.sumAt(version, start, end) << '\n';
+    } else {
+        out << "Error: version " << version << " is not retained" << '\n';
+    }
+}
+
+// Function to apply one op through the backend, answering sums; versions, when given,
+// records every update for sumat
+void applyOp(const BatchOp& op, FastOutput& out, RangeSumBackend& backend, PersistentSegmentTree* versions) {
+    switch (op.kind) {
+        case 'u': // sum
+            out << backend.sum(op.a, op.b) << '\n';
+            break;
+        case 'e': // set: through the selected backend, keeping arr in sync
+            backend.set(op.a, op.b);
+            if (versions) {
+                versions->set(op.a, op.b);
+            }
+            break;
+        case 'd': // add
+            backend.add(op.a, op.b, (int)op.c);
+            if (versions) {
+                versions->add(op.a, op.b, (int)op.c);
+            }
+            break;
+        case 'a': // assign
+            backend.assign(op.a, op.b, (int)op.c);
+            if (versions) {
+                versions->assign(op.a, op.b, (int)op.c);
+            }
+            break;
+        case 'v': // sumat
+            answerSumAt(out, *versions, op.c, op.a, op.b);
+            break;
+    }
+}
+
+// Function to apply the ops one at a time in log order, answering each sum as it comes
+void processStream(const vector<BatchOp>& ops, FastOutput& out, RangeSumBackend& backend, PersistentSegmentTree* versions) {
+    for (const BatchOp& op : ops) {
+        applyOp(op, out, backend, versions);
+    }
+}
+
+// Function to read the whole log of m ops, then answer it epoch by epoch. sumat ops are
+// answered afterwards from a version history replayed over the log, in their place.
+// BatchQueries only folds point sets, so a log with add or assign goes through the lazy
+// segment tree instead: updates apply in order, and each run of sums between them is one
+// epoch answered on the threads against the tree as it stands.
+void processBatch(const vector<BatchOp>& ops, FastOutput& out, int* arr, int n, unsigned threads, size_t history) {
+    unique_ptr<PersistentSegmentTree> versions;
+    if (hasOp(ops, "v")) {
+        versions = make_unique<PersistentSegmentTree>(arr, n, history); // Before arr changes
+    }
+    if (hasOp(ops, "da")) {
+        LazySegmentTreeBackend backend(arr, n);
+        vector<long long> sums;
+        size_t i = 0;
+        while (i < ops.size()) {
+            if (ops[i].kind != 'u') {
+                applyOp(ops[i], out, backend, versions.get());
+                ++i;
+                continue;
+            }
+            size_t first = i;
+            while (i < ops.size() && ops[i].kind == 'u') {
+                ++i;
+            }
+            sums.resize(i - first);
+            runEpoch(i - first, threads, [&](size_t k) {
+                sums[k] = backend.peekSum(ops[first + k].a, ops[first + k].b);
+            });
+            for (long long result : sums) {
+                out << result << '\n';
+            }
+        }
+        backend.sync();
+        return;
+    }
+    BatchQueries queries(arr, n, threads);
+    vector<long long> sums = queries.run(ops);
+    if (!versions) {
+        for (long long result : sums) {
+            out << result << '\n';
+        }
+        return;
+    }
+    size_t next = 0;
+    for (const BatchOp& op : ops) {
+        if (op.kind == 'u') {
+            out << sums[next++] << '\n';
+        } else if (op.kind == 'e') {
+            versions->set(op.a, op.b);
+        } else if (op.kind == 'v') {
+            answerSumAt(out, *versions, op.c, op.a, op.b);
+        }
+    }
+}
+
+// Function to apply m ops to a mapped array; indices may exceed int. Range updates go
+// element by element, and sumat needs the in-memory history, so it gets an error line.
+void processMapped(FastInput& in, FastOutput& out, MappedArray& array, long long m) {
+    for (long long i = 0; i < m; ++i) {
+        char kind = opKind(in.readToken());
+        switch (kind) {
+            case 'u': { // sum
+                long long start = in.readLong();
+                long long end = in.readLong();
+                out << array.sum(start, end) << '\n';
+                break;
+            }
+            case 'e': { // set: written back to the mapped page
+                long long idx = in.readLong();
+                array.set(idx, in.readInt());
+                break;
+            }
+            case 'd':   // add
+            case 'a': { // assign
+                long long start = in.readLong();
+                long long end = in.readLong();
+                int val = in.readInt();
+                for (long long idx = start; idx <= end; ++idx) {
+                    array.set(idx, kind == 'd' ? array.get(idx) + val : val);
+                }
+                break;
+            }
+            case 'v': // sumat
+                in.readLong();
+                in.readLong();
+                in.readLong();
+                out << "Error: sumat is not available on a mapped array" << '\n';
+                break;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Range-sum backend selection: --backend=linear|fenwick|segment|lazy|sharded
+    // (default: fenwick, or lazy when the log has add or assign ops)
+    // Linear-scan kernel selection: --kernel=auto|scalar|sse|avx2
+    // Offline mode: --batch [--threads=N] reads the whole op log and answers it in epochs of
+    // sums on N threads. It picks its own engine (BatchQueries, or the lazy tree when the
+    // log has add or assign ops), so it can't be combined with --backend
+    // Version history for sumat: --history=K keeps the latest K versions (0 keeps all)
+    // Out-of-core array: --make-array=PATH [--block=N] writes the input array to PATH (plus
+    // PATH.idx) and stops; --mmap=PATH then works on it, reading only "m" and the ops
+    string backendName;
+    string kernelName = "auto";
+    bool batch = false;
+    unsigned threads = thread::hardware_concurrency();
+    size_t history = 65536;
+    string mmapPath;
+    string makeArrayPath;
+    long long blockSize = 4096;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--backend=", 0) == 0) {
+            backendName = arg.substr(10);
+        } else if (arg.rfind("--kernel=", 0) == 0) {
+            kernelName = arg.substr(9);
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            threads = stoi(arg.substr(10));
+        } else if (arg.rfind("--history=", 0) == 0) {
+            history = stoull(arg.substr(10));
+        } else if (arg.rfind("--mmap=", 0) == 0) {
+            mmapPath = arg.substr(7);
+        } else if (arg.rfind("--make-array=", 0) == 0) {
+            makeArrayPath = arg.substr(13);
+        } else if (arg.rfind("--block=", 0) == 0) {
+            blockSize = clamp(stoll(arg.substr(8)), 1LL, 1LL << 30);
+        }
+    }
+    if (batch && !backendName.empty()) {
+        cerr << "Error: --backend does not apply to --batch." << endl;
+        return 1;
+    }
+    sumKernel = selectSumKernel(kernelName);
+    if (!sumKernel) {
+        cerr << "Error: Kernel " << kernelName << " is not available." << endl;
+        return 1;
+    }
+
+    FastInput in;
+    FastOutput out;
+    if (!mmapPath.empty()) {
+        MappedArray array;
+        string error;
+        if (!array.open(mmapPath, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+        processMapped(in, out, array, in.readLong());
+        array.flush(); // The array lives in the file; there is no final dump
+        return 0;
+    }
+    if (!makeArrayPath.empty()) {
+        // n may exceed int and RAM: the values stream from the input straight to the file
+        long long count = in.readLong();
+        in.readLong(); // m: the ops are for a later --mmap run
+        string error;
+        if (!MappedArray::create(makeArrayPath, count, blockSize, [&in] { return in.readInt(); }, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+        return 0;
+    }
+    int n = in.readInt();
+    int m = in.readInt();
 
     // Reading the array
     vector<int> data(n);
-    int* arr = &data[0];
+    int* arr = data.data();
     for (int i = 0; i < n; ++i) {
-        cin >> *(arr + i);
+        *(arr + i) = in.readInt();
     }
 
-    // Processing operations
-    for (int i = 0; i < m; ++i) {
-        string op;
-        cin >> op;
-
-        if (op == "sum") {
-            int start, end;
-            cin >> start >> end;
-            // Calculate sum using pointers and references
-            cout << calculateSum(arr, start, end) << endl;
-        } else if (op == "set") {
-            int idx, val;
-            cin >> idx >> val;
-            // Set value using pointers and references
-            setElement(arr, idx, val);
+    vector<BatchOp> ops = readOps(in, m);
+    if (batch) {
+        processBatch(ops, out, arr, n, threads, history);
+    } else {
+        if (backendName.empty()) {
+            backendName = hasOp(ops, "da") ? "lazy" : "fenwick";
+        }
+        unique_ptr<RangeSumBackend> backend = makeBackend(backendName, arr, n);
+        if (!backend) {
+            cerr << "Error: Unknown backend " << backendName << "." << endl;
+            return 1;
+        }
+        // The history costs a tree copy up front and O(log n) per update, so it is only kept
+        // when the log has a sumat
+        unique_ptr<PersistentSegmentTree> versions;
+        if (hasOp(ops, "v")) {
+            versions = make_unique<PersistentSegmentTree>(arr, n, history);
         }
+        processStream(ops, out, *backend, versions.get());
+        backend->sync();
     }
 
     // Output the modified array
     for (int i = 0; i < n; ++i) {
-        cout << *(arr + i) << " ";
+        out << *(arr + i) << ' ';
     }
-    cout << endl;
+    out << '\n';
 
     return 0;
 }
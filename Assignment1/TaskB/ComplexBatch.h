@@ -0,0 +1,258 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "ComplexDivision.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define TASKB_X86_KERNELS 1
+#endif
+
+// Operands of one opcode group in structure-of-arrays form: (a+bi) op (c+di)
+template<typename T>
+struct ComplexGroup {
+    std::vector<T> a, b, c, d;
+    std::vector<T> re, im; // Results; for '=' re holds 1 (equal) or 0
+
+    size_t size() const { return a.size(); }
+
+    void push(T a_, T b_, T c_, T d_) {
+        a.push_back(a_);
+        b.push_back(b_);
+        c.push_back(c_);
+        d.push_back(d_);
+    }
+};
+
+// Signature shared by every group kernel: processes lanes [first, count)
+template<typename T>
+using ComplexKernel = void (*)(const T* a, const T* b, const T* c, const T* d,
+                               T* re, T* im, size_t first, size_t count);
+
+// Scalar kernels; each mirrors the matching Complex operator term for term so the
+// batch path produces bit-identical results to the one-line-at-a-time path
+template<typename T>
+void addScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        re[i] = a[i] + c[i];
+        im[i] = b[i] + d[i];
+    }
+}
+
+template<typename T>
+void subScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        re[i] = a[i] - c[i];
+        im[i] = b[i] - d[i];
+    }
+}
+
+template<typename T>
+void mulScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        re[i] = a[i] * c[i] - b[i] * d[i];
+        im[i] = a[i] * d[i] + b[i] * c[i];
+    }
+}
+
+template<typename T>
+void divScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        divideNaive(a[i], b[i], c[i], d[i], re[i], im[i]);
+    }
+}
+
+template<typename T>
+void divReciprocalScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        divideReciprocal(a[i], b[i], c[i], d[i], re[i], im[i]);
+    }
+}
+
+template<typename T>
+void divSmithScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        divideSmith(a[i], b[i], c[i], d[i], re[i], im[i]);
+    }
+}
+
+template<typename T>
+void divBaudinScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        divideBaudin(a[i], b[i], c[i], d[i], re[i], im[i]);
+    }
+}
+
+template<typename T>
+void eqScalar(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        re[i] = (a[i] == c[i]) && (b[i] == d[i]) ? T(1) : T(0);
+        im[i] = T(0);
+    }
+}
+
+#ifdef TASKB_X86_KERNELS
+
+// AVX2 kernels, 4 doubles or 8 floats per step with a scalar loop for the tail. No FMA
+// is used, so every lane rounds exactly like the scalar expressions above.
+// V is the vector type, S the intrinsic suffix (pd/ps) and W the lane count.
+#define TASKB_AVX2_KERNEL(name, T, V, S, W, scalar, body)                                   \
+    __attribute__((target("avx2")))                                                        \
+    inline void name(const T* a, const T* b, const T* c, const T* d,                       \
+                     T* re, T* im, size_t first, size_t count) {                           \
+        size_t i = first;                                                                  \
+        for (; i + W <= count; i += W) {                                                   \
+            V va = _mm256_loadu_##S(a + i), vb = _mm256_loadu_##S(b + i);                  \
+            V vc = _mm256_loadu_##S(c + i), vd = _mm256_loadu_##S(d + i);                  \
+            V vre, vim;                                                                    \
+            body                                                                           \
+            _mm256_storeu_##S(re + i, vre);                                                \
+            _mm256_storeu_##S(im + i, vim);                                                \
+        }                                                                                  \
+        scalar<T>(a, b, c, d, re, im, i, count);                                           \
+    }
+
+#define TASKB_AVX2_KERNEL_SET(T, V, S, W)                                                  \
+    TASKB_AVX2_KERNEL(addAvx2, T, V, S, W, addScalar,                                      \
+        vre = _mm256_add_##S(va, vc);                                                      \
+        vim = _mm256_add_##S(vb, vd);)                                                     \
+    TASKB_AVX2_KERNEL(subAvx2, T, V, S, W, subScalar,                                      \
+        vre = _mm256_sub_##S(va, vc);                                                      \
+        vim = _mm256_sub_##S(vb, vd);)                                                     \
+    TASKB_AVX2_KERNEL(mulAvx2, T, V, S, W, mulScalar,                                      \
+        vre = _mm256_sub_##S(_mm256_mul_##S(va, vc), _mm256_mul_##S(vb, vd));              \
+        vim = _mm256_add_##S(_mm256_mul_##S(va, vd), _mm256_mul_##S(vb, vc));)             \
+    TASKB_AVX2_KERNEL(divAvx2, T, V, S, W, divScalar,                                      \
+        V den = _mm256_add_##S(_mm256_mul_##S(vc, vc), _mm256_mul_##S(vd, vd));            \
+        vre = _mm256_div_##S(_mm256_add_##S(_mm256_mul_##S(va, vc), _mm256_mul_##S(vb, vd)), den); \
+        vim = _mm256_div_##S(_mm256_sub_##S(_mm256_mul_##S(vb, vc), _mm256_mul_##S(va, vd)), den);) \
+    TASKB_AVX2_KERNEL(divReciprocalAvx2, T, V, S, W, divReciprocalScalar,                  \
+        V den = _mm256_add_##S(_mm256_mul_##S(vc, vc), _mm256_mul_##S(vd, vd));            \
+        V inverse = _mm256_div_##S(_mm256_set1_##S(1), den);                               \
+        vre = _mm256_mul_##S(_mm256_add_##S(_mm256_mul_##S(va, vc), _mm256_mul_##S(vb, vd)), inverse); \
+        vim = _mm256_mul_##S(_mm256_sub_##S(_mm256_mul_##S(vb, vc), _mm256_mul_##S(va, vd)), inverse);) \
+    TASKB_AVX2_KERNEL(eqAvx2, T, V, S, W, eqScalar,                                        \
+        V same = _mm256_and_##S(_mm256_cmp_##S(va, vc, _CMP_EQ_OQ), _mm256_cmp_##S(vb, vd, _CMP_EQ_OQ)); \
+        vre = _mm256_and_##S(same, _mm256_set1_##S(1));                                    \
+        vim = _mm256_setzero_##S();)
+
+TASKB_AVX2_KERNEL_SET(double, __m256d, pd, 4)
+TASKB_AVX2_KERNEL_SET(float, __m256, ps, 8)
+
+#undef TASKB_AVX2_KERNEL_SET
+#undef TASKB_AVX2_KERNEL
+
+#endif
+
+// AVX2 kernels for T in add, sub, mul, div, eq order; false if T has none or the CPU lacks AVX2
+template<typename T>
+bool simdKernels(ComplexKernel<T>* kernels) {
+#ifdef TASKB_X86_KERNELS
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            ComplexKernel<T> simd[] = {addAvx2, subAvx2, mulAvx2, divAvx2, eqAvx2};
+            for (int g = 0; g < 5; ++g) {
+                kernels[g] = simd[g];
+            }
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+// Kernel for the div group under --div=reciprocal: AVX2 when useSimd and available
+template<typename T>
+ComplexKernel<T> reciprocalDivKernel(bool useSimd) {
+#ifdef TASKB_X86_KERNELS
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        __builtin_cpu_init();
+        if (useSimd && __builtin_cpu_supports("avx2")) {
+            return divReciprocalAvx2;
+        }
+    }
+#endif
+    return divReciprocalScalar<T>;
+}
+
+// Batch engine: operations are appended into one SoA group per opcode while an order
+// log remembers (group, slot) per input line, so results can be replayed in input order
+template<typename T>
+class ComplexBatch {
+public:
+    static constexpr const char* opcodes = "+-*/=";
+    static constexpr int groupCount = 5;
+
+private:
+    ComplexGroup<T> groups[groupCount];
+    std::vector<int> order; // Group per input line, -1 for unknown opcodes
+    ComplexKernel<T> kernels[groupCount] = {addScalar<T>, subScalar<T>, mulScalar<T>, divScalar<T>, eqScalar<T>};
+
+public:
+    // Smith and Baudin division are branchy, so they always run on the scalar kernels
+    explicit ComplexBatch(bool useSimd = true, DivisionAlgorithm division = DivisionAlgorithm::Naive) {
+        if (useSimd) {
+            simdKernels<T>(kernels);
+        }
+        if (division == DivisionAlgorithm::Reciprocal) {
+            kernels[3] = reciprocalDivKernel<T>(useSimd);
+        } else if (division == DivisionAlgorithm::Smith) {
+            kernels[3] = divSmithScalar<T>;
+        } else if (division == DivisionAlgorithm::Baudin) {
+            kernels[3] = divBaudinScalar<T>;
+        }
+    }
+
+    // Replaces the kernel of one opcode group, e.g. '=' under a tolerant comparison
+    void setKernel(char op, ComplexKernel<T> kernel) {
+        const char* found = std::strchr(opcodes, op);
+        if (op != '\0' && found) {
+            kernels[found - opcodes] = kernel;
+        }
+    }
+
+    // Queues one "op a b c d" line
+    void push(char op, T a, T b, T c, T d) {
+        int g = -1;
+        switch (op) {
+            case '+': g = 0; break;
+            case '-': g = 1; break;
+            case '*': g = 2; break;
+            case '/': g = 3; break;
+            case '=': g = 4; break;
+        }
+        order.push_back(g);
+        if (g >= 0) {
+            groups[g].push(a, b, c, d);
+        }
+    }
+
+    // Runs every group through its kernel
+    void run() {
+        for (int g = 0; g < groupCount; ++g) {
+            ComplexGroup<T>& group = groups[g];
+            group.re.resize(group.size());
+            group.im.resize(group.size());
+            kernels[g](group.a.data(), group.b.data(), group.c.data(), group.d.data(),
+                       group.re.data(), group.im.data(), 0, group.size());
+        }
+    }
+
+    // Calls visit(op, re, im) for every queued line in input order; op is '\0' if unknown
+    template<typename Visitor>
+    void forEachResult(Visitor visit) const {
+        size_t next[groupCount] = {};
+        for (int g : order) {
+            if (g < 0) {
+                visit('\0', T(0), T(0));
+                continue;
+            }
+            size_t slot = next[g]++;
+            visit(opcodes[g], groups[g].re[slot], groups[g].im[slot]);
+        }
+    }
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+// Algorithms for (a+bi) / (c+di) over float, double or long double, writing the quotient to e+fi
+enum class DivisionAlgorithm {
+    Naive,      // Textbook formula, dividing by c^2+d^2: overflows once |c|,|d| pass ~1e154
+    Reciprocal, // Textbook formula multiplying by 1/(c^2+d^2): fastest, may differ from naive in the last bit
+    Smith,  // Smith (1962): divides by the larger of |c|,|d| first, avoiding most overflow
+    Baudin  // Baudin & Smith (2012): Smith's ordering plus scaling of extreme operands
+};
+
+// Parses the --div=<name> flag value; returns false for unknown names
+inline bool parseDivisionAlgorithm(const std::string& name, DivisionAlgorithm& algorithm) {
+    if (name == "naive") {
+        algorithm = DivisionAlgorithm::Naive;
+    } else if (name == "reciprocal") {
+        algorithm = DivisionAlgorithm::Reciprocal;
+    } else if (name == "smith") {
+        algorithm = DivisionAlgorithm::Smith;
+    } else if (name == "baudin") {
+        algorithm = DivisionAlgorithm::Baudin;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Usable in constant expressions, so Complex<T>::operator/ can fold at compile time
+template<typename T>
+constexpr void divideNaive(T a, T b, T c, T d, T& e, T& f) noexcept {
+    T denominator = c * c + d * d;
+    e = (a * c + b * d) / denominator;
+    f = (b * c - a * d) / denominator;
+}
+
+// One division instead of two; the extra rounding of the reciprocal can move the last bit
+template<typename T>
+inline void divideReciprocal(T a, T b, T c, T d, T& e, T& f) noexcept {
+    T inverse = T(1) / (c * c + d * d);
+    e = (a * c + b * d) * inverse;
+    f = (b * c - a * d) * inverse;
+}
+
+template<typename T>
+inline void divideSmith(T a, T b, T c, T d, T& e, T& f) noexcept {
+    if (std::fabs(c) >= std::fabs(d)) {
+        T r = d / c;
+        T denominator = c + d * r;
+        e = (a + b * r) / denominator;
+        f = (b - a * r) / denominator;
+    } else {
+        T r = c / d;
+        T denominator = c * r + d;
+        e = (a * r + b) / denominator;
+        f = (b * r - a) / denominator;
+    }
+}
+
+// Real part of the robust quotient once |d| <= |c|; r = d/c and t = 1/(c + d*r)
+template<typename T>
+inline T baudinRealPart(T a, T b, T c, T d, T r, T t) noexcept {
+    if (r != 0) {
+        T br = b * r;
+        if (br != 0) {
+            return (a + br) * t;
+        }
+        return a * t + (b * t) * r;
+    }
+    return (a + d * (b / c)) * t;
+}
+
+template<typename T>
+inline void baudinInternal(T a, T b, T c, T d, T& e, T& f) noexcept {
+    T r = d / c;
+    T t = T(1) / (c + d * r);
+    e = baudinRealPart(a, b, c, d, r, t);
+    f = baudinRealPart(b, -a, c, d, r, t);
+}
+
+template<typename T>
+inline void divideBaudin(T a, T b, T c, T d, T& e, T& f) noexcept {
+    using limits = std::numeric_limits<T>;
+    const T overflowHalf = limits::max() / 2;
+    const T underflowLimit = limits::min() * 2 / limits::epsilon();
+    const T boost = 2 / (limits::epsilon() * limits::epsilon());
+    T ab = std::fmax(std::fabs(a), std::fabs(b));
+    T cd = std::fmax(std::fabs(c), std::fabs(d));
+    T scale = 1;
+    if (ab >= overflowHalf) {
+        a *= 0.5; b *= 0.5; scale *= 2;
+    }
+    if (cd >= overflowHalf) {
+        c *= 0.5; d *= 0.5; scale *= 0.5;
+    }
+    if (ab <= underflowLimit) {
+        a *= boost; b *= boost; scale /= boost;
+    }
+    if (cd <= underflowLimit) {
+        c *= boost; d *= boost; scale *= boost;
+    }
+    if (std::fabs(d) <= std::fabs(c)) {
+        baudinInternal(a, b, c, d, e, f);
+    } else {
+        baudinInternal(b, a, d, c, e, f);
+        f = -f;
+    }
+    e *= scale;
+    f *= scale;
+}
+
+template<typename T>
+inline void divide(DivisionAlgorithm algorithm, T a, T b, T c, T d, T& e, T& f) noexcept {
+    switch (algorithm) {
+        case DivisionAlgorithm::Naive:
+            divideNaive(a, b, c, d, e, f);
+            break;
+        case DivisionAlgorithm::Reciprocal:
+            divideReciprocal(a, b, c, d, e, f);
+            break;
+        case DivisionAlgorithm::Smith:
+            divideSmith(a, b, c, d, e, f);
+            break;
+        case DivisionAlgorithm::Baudin:
+            divideBaudin(a, b, c, d, e, f);
+            break;
+    }
+}
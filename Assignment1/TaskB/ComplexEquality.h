@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+// How Complex values are compared for '=' and for deduplication
+enum class EqualityMode {
+    Exact,   // Bitwise-value equality of both parts (the original behaviour)
+    Epsilon, // Each part within an absolute tolerance
+    Ulp      // Each part within a number of units in the last place
+};
+
+// Run-time comparison settings, shared by all precisions
+struct EqualitySettings {
+    EqualityMode mode = EqualityMode::Exact;
+    long double tolerance = 0; // Epsilon mode
+    long long ulps = 0;        // Ulp mode
+};
+
+// Parses the --eq=exact|eps:<tolerance>|ulp:<count> flag value; returns false if malformed
+inline bool parseEqualitySettings(const std::string& value, EqualitySettings& settings) {
+    try {
+        if (value == "exact") {
+            settings.mode = EqualityMode::Exact;
+        } else if (value.rfind("eps:", 0) == 0) {
+            settings.mode = EqualityMode::Epsilon;
+            settings.tolerance = std::stold(value.substr(4));
+            return settings.tolerance > 0;
+        } else if (value.rfind("ulp:", 0) == 0) {
+            settings.mode = EqualityMode::Ulp;
+            settings.ulps = std::stoll(value.substr(4));
+            return settings.ulps >= 0;
+        } else {
+            return false;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+// Position of x among all finite values of T: adjacent representable values differ by 1,
+// so the distance between two ordinals is their distance in ulps. -0 and +0 share 0.
+template<typename T>
+__int128 ulpOrdinal(T x) {
+    using limits = std::numeric_limits<T>;
+    const int digits = limits::digits;
+    T magnitude = std::fabs(x);
+    __int128 ordinal;
+    if (magnitude < limits::min()) {
+        ordinal = (__int128)std::ldexp(magnitude, digits - limits::min_exponent); // subnormal: linear
+    } else {
+        int exponent;
+        T mantissa = std::frexp(magnitude, &exponent); // [0.5, 1)
+        ordinal = (__int128)(exponent - limits::min_exponent) * ((__int128)1 << (digits - 1)) +
+                  (__int128)std::ldexp(mantissa, digits);
+    }
+    return x < 0 ? -ordinal : ordinal;
+}
+
+// Floor division for the signed cell computations below
+inline __int128 floorDiv(__int128 value, __int128 divisor) {
+    __int128 q = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? q - 1 : q;
+}
+
+// Whether two parts compare equal under the settings
+template<typename T>
+bool partsEqual(T x, T y, const EqualitySettings& settings) {
+    if (x == y) {
+        return true;
+    }
+    switch (settings.mode) {
+        case EqualityMode::Exact:
+            return false;
+        case EqualityMode::Epsilon:
+            return std::fabs(x - y) <= settings.tolerance;
+        case EqualityMode::Ulp: {
+            if (!std::isfinite(x) || !std::isfinite(y)) {
+                return false;
+            }
+            __int128 distance = ulpOrdinal(x) - ulpOrdinal(y);
+            return (distance < 0 ? -distance : distance) <= settings.ulps;
+        }
+    }
+    return false;
+}
+
+// Grid cell of one part: any two parts that compare equal land in the same cell or in
+// adjacent ones (exact mode: always the same one), which is what makes hashing possible
+template<typename T>
+__int128 partCell(T x, const EqualitySettings& settings) {
+    if (!std::isfinite(x)) {
+        return std::isnan(x) ? 0 : (x > 0 ? 1 : -1) * ((__int128)1 << 120); // inf pairs; NaN never matches
+    }
+    switch (settings.mode) {
+        case EqualityMode::Exact:
+            return ulpOrdinal(x);
+        case EqualityMode::Epsilon: {
+            long double scaled = std::floor((long double)x / settings.tolerance);
+            const long double limit = 1e36L; // keep the cast in range; huge values just share cells
+            return (__int128)std::fmax(-limit, std::fmin(limit, scaled));
+        }
+        case EqualityMode::Ulp:
+            return floorDiv(ulpOrdinal(x), (__int128)settings.ulps + 1);
+    }
+    return 0;
+}
+
+// How many neighbouring cells per dimension a lookup has to visit
+inline int cellRadius(const EqualitySettings& settings) {
+    return settings.mode == EqualityMode::Exact ? 0 : 1;
+}
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define TASKB_X86_KERNELS 1
+#endif
+
+// Signature shared by the radix-4 stage kernels: runs one fused pair of radix-2 stages
+// (spans L and 2L) over every block of 4L points in [0, count) of the SoA arrays re/im.
+// w1 holds W_2L^j and w2 holds W_4L^j for j < L, where W_k = e^(-2 pi i / k).
+template<typename T>
+using FFTStageKernel = void (*)(T* re, T* im, size_t count, size_t L,
+                                const T* w1r, const T* w1i, const T* w2r, const T* w2i);
+
+template<typename T>
+void radix4Scalar(T* re, T* im, size_t count, size_t L, const T* w1r, const T* w1i, const T* w2r, const T* w2i) {
+    for (size_t block = 0; block < count; block += 4 * L) {
+        T *r0 = re + block, *r1 = r0 + L, *r2 = r1 + L, *r3 = r2 + L;
+        T *i0 = im + block, *i1 = i0 + L, *i2 = i1 + L, *i3 = i2 + L;
+        for (size_t j = 0; j < L; ++j) {
+            // Span L: (x0, x1) and (x2, x3), both by W_2L^j
+            T t1r = r1[j] * w1r[j] - i1[j] * w1i[j];
+            T t1i = r1[j] * w1i[j] + i1[j] * w1r[j];
+            T t3r = r3[j] * w1r[j] - i3[j] * w1i[j];
+            T t3i = r3[j] * w1i[j] + i3[j] * w1r[j];
+            T a0r = r0[j] + t1r, a0i = i0[j] + t1i;
+            T a1r = r0[j] - t1r, a1i = i0[j] - t1i;
+            T a2r = r2[j] + t3r, a2i = i2[j] + t3i;
+            T a3r = r2[j] - t3r, a3i = i2[j] - t3i;
+            // Span 2L: (a0, a2) by W_4L^j and (a1, a3) by W_4L^(j+L) = -i W_4L^j
+            T ur = a2r * w2r[j] - a2i * w2i[j];
+            T ui = a2r * w2i[j] + a2i * w2r[j];
+            T vr = a3r * w2i[j] + a3i * w2r[j];
+            T vi = a3i * w2i[j] - a3r * w2r[j];
+            r0[j] = a0r + ur;
+            i0[j] = a0i + ui;
+            r2[j] = a0r - ur;
+            i2[j] = a0i - ui;
+            r1[j] = a1r + vr;
+            i1[j] = a1i + vi;
+            r3[j] = a1r - vr;
+            i3[j] = a1i - vi;
+        }
+    }
+}
+
+#ifdef TASKB_X86_KERNELS
+
+// AVX2 radix-4 kernels, 4 doubles or 8 floats per step; spans narrower than a vector use
+// the scalar kernel. No FMA, so every lane rounds like the scalar expressions above.
+#define TASKB_FFT_AVX2_KERNEL(name, T, V, S, W)                                             \
+    __attribute__((target("avx2")))                                                        \
+    inline void name(T* re, T* im, size_t count, size_t L,                                 \
+                     const T* w1r, const T* w1i, const T* w2r, const T* w2i) {             \
+        if (L < W) {                                                                       \
+            radix4Scalar<T>(re, im, count, L, w1r, w1i, w2r, w2i);                         \
+            return;                                                                        \
+        }                                                                                  \
+        for (size_t block = 0; block < count; block += 4 * L) {                            \
+            T *r0 = re + block, *r1 = r0 + L, *r2 = r1 + L, *r3 = r2 + L;                  \
+            T *i0 = im + block, *i1 = i0 + L, *i2 = i1 + L, *i3 = i2 + L;                  \
+            for (size_t j = 0; j < L; j += W) {                                            \
+                V c1r = _mm256_loadu_##S(w1r + j), c1i = _mm256_loadu_##S(w1i + j);        \
+                V c2r = _mm256_loadu_##S(w2r + j), c2i = _mm256_loadu_##S(w2i + j);        \
+                V x0r = _mm256_loadu_##S(r0 + j), x0i = _mm256_loadu_##S(i0 + j);          \
+                V x1r = _mm256_loadu_##S(r1 + j), x1i = _mm256_loadu_##S(i1 + j);          \
+                V x2r = _mm256_loadu_##S(r2 + j), x2i = _mm256_loadu_##S(i2 + j);          \
+                V x3r = _mm256_loadu_##S(r3 + j), x3i = _mm256_loadu_##S(i3 + j);          \
+                V t1r = _mm256_sub_##S(_mm256_mul_##S(x1r, c1r), _mm256_mul_##S(x1i, c1i)); \
+                V t1i = _mm256_add_##S(_mm256_mul_##S(x1r, c1i), _mm256_mul_##S(x1i, c1r)); \
+                V t3r = _mm256_sub_##S(_mm256_mul_##S(x3r, c1r), _mm256_mul_##S(x3i, c1i)); \
+                V t3i = _mm256_add_##S(_mm256_mul_##S(x3r, c1i), _mm256_mul_##S(x3i, c1r)); \
+                V a0r = _mm256_add_##S(x0r, t1r), a0i = _mm256_add_##S(x0i, t1i);          \
+                V a1r = _mm256_sub_##S(x0r, t1r), a1i = _mm256_sub_##S(x0i, t1i);          \
+                V a2r = _mm256_add_##S(x2r, t3r), a2i = _mm256_add_##S(x2i, t3i);          \
+                V a3r = _mm256_sub_##S(x2r, t3r), a3i = _mm256_sub_##S(x2i, t3i);          \
+                V ur = _mm256_sub_##S(_mm256_mul_##S(a2r, c2r), _mm256_mul_##S(a2i, c2i));  \
+                V ui = _mm256_add_##S(_mm256_mul_##S(a2r, c2i), _mm256_mul_##S(a2i, c2r));  \
+                V vr = _mm256_add_##S(_mm256_mul_##S(a3r, c2i), _mm256_mul_##S(a3i, c2r));  \
+                V vi = _mm256_sub_##S(_mm256_mul_##S(a3i, c2i), _mm256_mul_##S(a3r, c2r));  \
+                _mm256_storeu_##S(r0 + j, _mm256_add_##S(a0r, ur));                         \
+                _mm256_storeu_##S(i0 + j, _mm256_add_##S(a0i, ui));                         \
+                _mm256_storeu_##S(r2 + j, _mm256_sub_##S(a0r, ur));                         \
+                _mm256_storeu_##S(i2 + j, _mm256_sub_##S(a0i, ui));                         \
+                _mm256_storeu_##S(r1 + j, _mm256_add_##S(a1r, vr));                         \
+                _mm256_storeu_##S(i1 + j, _mm256_add_##S(a1i, vi));                         \
+                _mm256_storeu_##S(r3 + j, _mm256_sub_##S(a1r, vr));                         \
+                _mm256_storeu_##S(i3 + j, _mm256_sub_##S(a1i, vi));                         \
+            }                                                                              \
+        }                                                                                  \
+    }
+
+TASKB_FFT_AVX2_KERNEL(radix4Avx2, double, __m256d, pd, 4)
+TASKB_FFT_AVX2_KERNEL(radix4Avx2, float, __m256, ps, 8)
+
+#undef TASKB_FFT_AVX2_KERNEL
+
+#endif
+
+// AVX2 stage kernel for T, or nullptr if T has none or the CPU lacks AVX2
+template<typename T>
+FFTStageKernel<T> simdStageKernel() {
+#ifdef TASKB_X86_KERNELS
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return static_cast<FFTStageKernel<T>>(radix4Avx2);
+        }
+    }
+#endif
+    return nullptr;
+}
+
+// Iterative FFT of one power-of-two size over SoA arrays. The plan precomputes a contiguous
+// twiddle table per stage and the bit-reversal tiles, so transforms only do arithmetic.
+// - Bit reversal works in Q x Q tiles (Q = 32): index bits [a | b | c] go to
+//   [rev(c) | rev(b) | rev(a)], so each tile is read in rows and written in rows through a
+//   small buffer instead of scattering single points across the whole array.
+// - Butterflies run as fused radix-4 stages, after one radix-2 stage when log n is odd.
+//   Stages whose blocks fit in cacheBlock points run chunk by chunk while the chunk is hot.
+template<typename T>
+class FFTPlan {
+private:
+    static constexpr int tileBits = 5;
+    static constexpr size_t cacheBlock = 1 << 12;
+
+    struct Stage {
+        size_t L;      // Quarter of the block size
+        size_t offset; // Of this stage's L twiddles in w1r/w1i/w2r/w2i
+    };
+
+    size_t n;
+    int logN = 0;
+    int tileLog;    // log2 of the tile side Q
+    int middleLog;  // Bits between the two tile halves: logN = 2 tileLog + middleLog
+    std::vector<size_t> tileReverse; // tileLog-bit reversal of 0 .. Q-1
+    std::vector<T> tileRe, tileIm;
+    std::vector<Stage> stages;
+    std::vector<T> w1r, w1i, w2r, w2i;
+    FFTStageKernel<T> kernel = radix4Scalar<T>;
+
+    static size_t reverseBits(size_t x, int bits) {
+        size_t reversed = 0;
+        for (int i = 0; i < bits; ++i) {
+            reversed = (reversed << 1) | ((x >> i) & 1);
+        }
+        return reversed;
+    }
+
+    void bitReverse(const T* srcRe, const T* srcIm, T* dstRe, T* dstIm) {
+        size_t Q = size_t(1) << tileLog;
+        int highShift = middleLog + tileLog;
+        for (size_t b = 0; b < (size_t(1) << middleLog); ++b) {
+            size_t bReversed = reverseBits(b, middleLog);
+            for (size_t a = 0; a < Q; ++a) {
+                size_t from = (a << highShift) | (b << tileLog);
+                size_t row = tileReverse[a] << tileLog;
+                for (size_t c = 0; c < Q; ++c) {
+                    tileRe[row | c] = srcRe[from + c];
+                    tileIm[row | c] = srcIm[from + c];
+                }
+            }
+            for (size_t c = 0; c < Q; ++c) {
+                size_t to = (tileReverse[c] << highShift) | (bReversed << tileLog);
+                for (size_t a = 0; a < Q; ++a) {
+                    dstRe[to + a] = tileRe[(a << tileLog) | c];
+                    dstIm[to + a] = tileIm[(a << tileLog) | c];
+                }
+            }
+        }
+    }
+
+    void runStage(const Stage& stage, T* re, T* im, size_t count) const {
+        kernel(re, im, count, stage.L, w1r.data() + stage.offset, w1i.data() + stage.offset,
+               w2r.data() + stage.offset, w2i.data() + stage.offset);
+    }
+
+    // Decimation-in-time butterflies over bit-reversed data
+    void butterflies(T* re, T* im) const {
+        size_t chunk = std::min(n, cacheBlock);
+        size_t early = 0;
+        while (early < stages.size() && 4 * stages[early].L <= chunk) {
+            ++early;
+        }
+        for (size_t start = 0; start < n; start += chunk) {
+            if (logN % 2) { // Leading radix-2 stage: twiddles are all 1
+                for (size_t i = start; i < start + chunk; i += 2) {
+                    T xr = re[i], xi = im[i];
+                    re[i] = xr + re[i + 1];
+                    im[i] = xi + im[i + 1];
+                    re[i + 1] = xr - re[i + 1];
+                    im[i + 1] = xi - im[i + 1];
+                }
+            }
+            for (size_t k = 0; k < early; ++k) {
+                runStage(stages[k], re + start, im + start, chunk);
+            }
+        }
+        for (size_t k = early; k < stages.size(); ++k) {
+            runStage(stages[k], re, im, n);
+        }
+    }
+
+public:
+    // n must be a power of two
+    explicit FFTPlan(size_t n, bool useSimd = true) : n(n) {
+        while ((size_t(1) << logN) < n) {
+            ++logN;
+        }
+        tileLog = std::min(tileBits, logN / 2);
+        middleLog = logN - 2 * tileLog;
+        for (size_t c = 0; c < (size_t(1) << tileLog); ++c) {
+            tileReverse.push_back(reverseBits(c, tileLog));
+        }
+        tileRe.resize(size_t(1) << (2 * tileLog));
+        tileIm.resize(tileRe.size());
+
+        // Every twiddle is some W_n^k with k < n/2; cos(2 pi k / n) for k <= n/4 gives them all.
+        // Evaluated in double for float and double plans (x87 cosl is over 100x slower)
+        using Trig = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+        const Trig pi = (Trig)3.141592653589793238462643383279502884L;
+        size_t quarter = n / 4;
+        std::vector<Trig> cosine(quarter + 1);
+        for (size_t k = 0; k <= quarter; ++k) {
+            cosine[k] = std::cos(2 * pi * k / n);
+        }
+        auto push = [&](std::vector<T>& re, std::vector<T>& im, size_t k) {
+            re.push_back((T)(k <= quarter ? cosine[k] : -cosine[2 * quarter - k]));
+            im.push_back((T)(k <= quarter ? -cosine[quarter - k] : -cosine[k - quarter]));
+        };
+        for (size_t L = logN % 2 ? 2 : 1; 4 * L <= n; L *= 4) {
+            stages.push_back({L, w1r.size()});
+            for (size_t j = 0; j < L; ++j) {
+                push(w1r, w1i, j * (n / (2 * L)));
+                push(w2r, w2i, j * (n / (4 * L)));
+            }
+        }
+        if (useSimd) {
+            if (FFTStageKernel<T> simd = simdStageKernel<T>()) {
+                kernel = simd;
+            }
+        }
+    }
+
+    size_t size() const { return n; }
+
+    // out = DFT(in); the in and out arrays must not overlap
+    void forward(const T* inRe, const T* inIm, T* outRe, T* outIm) {
+        bitReverse(inRe, inIm, outRe, outIm);
+        butterflies(outRe, outIm);
+    }
+
+    // out = inverse DFT(in), scaled by 1/n, as conj(DFT(conj(in))) / n
+    void inverse(const T* inRe, const T* inIm, T* outRe, T* outIm) {
+        bitReverse(inRe, inIm, outRe, outIm);
+        for (size_t i = 0; i < n; ++i) {
+            outIm[i] = -outIm[i];
+        }
+        butterflies(outRe, outIm);
+        T scale = T(1) / T(n);
+        for (size_t i = 0; i < n; ++i) {
+            outRe[i] *= scale;
+            outIm[i] *= -scale;
+        }
+    }
+};
+
+// Coefficients of a complex polynomial, lowest degree first, in SoA form
+template<typename T>
+struct ComplexPolynomial {
+    std::vector<T> re, im;
+
+    size_t size() const { return re.size(); }
+};
+
+// Schoolbook product in O(np * nq), with the same per-term arithmetic as Complex * and +
+template<typename T>
+ComplexPolynomial<T> multiplyNaive(const ComplexPolynomial<T>& p, const ComplexPolynomial<T>& q) {
+    ComplexPolynomial<T> product;
+    if (p.size() == 0 || q.size() == 0) {
+        return product;
+    }
+    product.re.assign(p.size() + q.size() - 1, T(0));
+    product.im.assign(product.re.size(), T(0));
+    for (size_t i = 0; i < p.size(); ++i) {
+        for (size_t j = 0; j < q.size(); ++j) {
+            product.re[i + j] += p.re[i] * q.re[j] - p.im[i] * q.im[j];
+            product.im[i + j] += p.re[i] * q.im[j] + p.im[i] * q.re[j];
+        }
+    }
+    return product;
+}
+
+// Product through FFTs of the next power of two >= np + nq - 1: O(n log n)
+template<typename T>
+ComplexPolynomial<T> multiplyFFT(const ComplexPolynomial<T>& p, const ComplexPolynomial<T>& q, bool useSimd = true) {
+    ComplexPolynomial<T> product;
+    if (p.size() == 0 || q.size() == 0) {
+        return product;
+    }
+    size_t length = p.size() + q.size() - 1;
+    size_t n = 1;
+    while (n < length) {
+        n *= 2;
+    }
+    FFTPlan<T> plan(n, useSimd);
+    std::vector<T> inRe(n), inIm(n), pr(n), pi(n), qr(n), qi(n);
+    std::copy(p.re.begin(), p.re.end(), inRe.begin());
+    std::copy(p.im.begin(), p.im.end(), inIm.begin());
+    plan.forward(inRe.data(), inIm.data(), pr.data(), pi.data());
+    std::fill(inRe.begin(), inRe.end(), T(0));
+    std::fill(inIm.begin(), inIm.end(), T(0));
+    std::copy(q.re.begin(), q.re.end(), inRe.begin());
+    std::copy(q.im.begin(), q.im.end(), inIm.begin());
+    plan.forward(inRe.data(), inIm.data(), qr.data(), qi.data());
+    for (size_t k = 0; k < n; ++k) { // Pointwise product, back into in
+        inRe[k] = pr[k] * qr[k] - pi[k] * qi[k];
+        inIm[k] = pr[k] * qi[k] + pi[k] * qr[k];
+    }
+    plan.inverse(inRe.data(), inIm.data(), pr.data(), pi.data());
+    product.re.assign(pr.begin(), pr.begin() + length);
+    product.im.assign(pi.begin(), pi.begin() + length);
+    return product;
+}
+
+// Bound on the absolute error of every multiplyFFT(p, q) coefficient: the roundings of the
+// transforms grow with log n and scale with the Euclidean norms of the inputs. Measured
+// errors stay below a quarter of eps (log n + 1) |p| |q|, so the factor 4 leaves 16x headroom;
+// ConvolutionBench checks every product against it.
+template<typename T>
+T fftProductErrorBound(const ComplexPolynomial<T>& p, const ComplexPolynomial<T>& q) {
+    auto norm = [](const ComplexPolynomial<T>& poly) {
+        T squares = 0;
+        for (size_t i = 0; i < poly.size(); ++i) {
+            squares += poly.re[i] * poly.re[i] + poly.im[i] * poly.im[i];
+        }
+        return std::sqrt(squares);
+    };
+    size_t n = 1;
+    int logN = 0;
+    while (n < p.size() + q.size() - 1) {
+        n *= 2;
+        ++logN;
+    }
+    return 4 * std::numeric_limits<T>::epsilon() * (logN + 1) * norm(p) * norm(q);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "ComplexEquality.h"
+
+// Open-addressing set of distinct complex values under an EqualitySettings comparison.
+// Each kept value is filed under its quantized (real, imaginary) cell with linear probing;
+// a lookup visits the value's own cell and, for tolerant modes, the 8 neighbouring ones,
+// so n inserts cost O(n) expected instead of the O(n^2) pairwise '=' checks.
+template<typename T>
+class ComplexSet {
+private:
+    struct Slot {
+        __int128 cellRe;
+        __int128 cellIm;
+        int value = -1; // Index into values; -1 marks an empty slot
+    };
+
+    EqualitySettings settings;
+    std::vector<Slot> slots; // Power-of-two capacity, kept at most half full
+    std::vector<T> re, im;   // Distinct values in first-seen order
+
+    static uint64_t mix(uint64_t x) {
+        // splitmix64 finalizer
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static uint64_t hashCell(__int128 cellRe, __int128 cellIm) {
+        uint64_t h = mix((uint64_t)cellRe ^ mix((uint64_t)(cellRe >> 64)));
+        return mix(h ^ (uint64_t)cellIm ^ mix((uint64_t)(cellIm >> 64) + 1));
+    }
+
+    void place(__int128 cellRe, __int128 cellIm, int value) {
+        size_t mask = slots.size() - 1;
+        size_t i = hashCell(cellRe, cellIm) & mask;
+        while (slots[i].value >= 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = Slot{cellRe, cellIm, value};
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        for (const Slot& slot : old) {
+            if (slot.value >= 0) {
+                place(slot.cellRe, slot.cellIm, slot.value);
+            }
+        }
+    }
+
+    // Whether a kept value filed under the given cell equals (a, b)
+    bool matchInCell(__int128 cellRe, __int128 cellIm, T a, T b) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = hashCell(cellRe, cellIm) & mask; slots[i].value >= 0; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.cellRe == cellRe && slot.cellIm == cellIm &&
+                partsEqual(re[slot.value], a, settings) && partsEqual(im[slot.value], b, settings)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit ComplexSet(const EqualitySettings& settings, size_t expected = 16) : settings(settings) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+        }
+        slots.resize(capacity);
+    }
+
+    // Whether a value equal to (a, b) is already kept
+    bool contains(T a, T b) const {
+        __int128 cellRe = partCell(a, settings);
+        __int128 cellIm = partCell(b, settings);
+        int radius = cellRadius(settings);
+        for (int dr = -radius; dr <= radius; ++dr) {
+            for (int di = -radius; di <= radius; ++di) {
+                if (matchInCell(cellRe + dr, cellIm + di, a, b)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Keeps (a, b) unless an equal value is already kept; returns true if it was new
+    bool insert(T a, T b) {
+        if (contains(a, b)) {
+            return false;
+        }
+        if ((re.size() + 1) * 2 > slots.size()) {
+            grow();
+        }
+        re.push_back(a);
+        im.push_back(b);
+        place(partCell(a, settings), partCell(b, settings), (int)re.size() - 1);
+        return true;
+    }
+
+    size_t size() const { return re.size(); }
+};
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "ComplexFFT.h"
+
+using namespace std;
+
+// Benchmark and accuracy report for the FFT polynomial product against the schoolbook one.
+// Usage: ConvolutionBench [max log2 size]. Coefficients have two decimals in [-10, 10] like
+// TaskB input; errors are the largest coefficient difference from the naive product, which
+// must stay within fftProductErrorBound. Also checks FFTPlan::forward against a direct
+// long double DFT and the forward/inverse round trip.
+
+ComplexPolynomial<double> generate(size_t count, mt19937_64& rng) {
+    uniform_int_distribution<int> hundredths(-1000, 1000);
+    ComplexPolynomial<double> poly;
+    for (size_t i = 0; i < count; ++i) {
+        poly.re.push_back(hundredths(rng) / 100.0);
+        poly.im.push_back(hundredths(rng) / 100.0);
+    }
+    return poly;
+}
+
+double maxDifference(const ComplexPolynomial<double>& x, const ComplexPolynomial<double>& y) {
+    double worst = 0;
+    for (size_t k = 0; k < x.size(); ++k) {
+        worst = max({worst, fabs(x.re[k] - y.re[k]), fabs(x.im[k] - y.im[k])});
+    }
+    return worst;
+}
+
+// Seconds per call of f, repeated until at least 0.2 s have passed
+template<typename F>
+double timeIt(F f) {
+    int reps = 0;
+    auto start = chrono::steady_clock::now();
+    double elapsed;
+    do {
+        f();
+        ++reps;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.2);
+    return elapsed / reps;
+}
+
+// Largest error of forward() against the O(n^2) DFT evaluated in long double
+double dftError(size_t n, mt19937_64& rng) {
+    ComplexPolynomial<double> x = generate(n, rng);
+    vector<double> re(n), im(n);
+    FFTPlan<double> plan(n);
+    plan.forward(x.re.data(), x.im.data(), re.data(), im.data());
+    const long double pi = 3.141592653589793238462643383279502884L;
+    double worst = 0;
+    for (size_t k = 0; k < n; ++k) {
+        long double sumRe = 0, sumIm = 0;
+        for (size_t j = 0; j < n; ++j) {
+            long double angle = -2 * pi * (long double)((j * k) % n) / n;
+            sumRe += x.re[j] * cosl(angle) - x.im[j] * sinl(angle);
+            sumIm += x.re[j] * sinl(angle) + x.im[j] * cosl(angle);
+        }
+        worst = max({worst, (double)fabsl(re[k] - sumRe), (double)fabsl(im[k] - sumIm)});
+    }
+    return worst;
+}
+
+// Largest error of inverse(forward(x)) against x
+double roundTripError(size_t n, mt19937_64& rng) {
+    ComplexPolynomial<double> x = generate(n, rng);
+    vector<double> re(n), im(n), backRe(n), backIm(n);
+    FFTPlan<double> plan(n);
+    plan.forward(x.re.data(), x.im.data(), re.data(), im.data());
+    plan.inverse(re.data(), im.data(), backRe.data(), backIm.data());
+    double worst = 0;
+    for (size_t k = 0; k < n; ++k) {
+        worst = max({worst, fabs(backRe[k] - x.re[k]), fabs(backIm[k] - x.im[k])});
+    }
+    return worst;
+}
+
+int main(int argc, char* argv[]) {
+    int maxLog = argc > 1 ? stoi(argv[1]) : 18;
+    mt19937_64 rng(2024);
+    bool ok = true;
+
+    cout << "FFT checks (double)" << endl;
+    cout << setw(8) << "n" << setw(14) << "vs DFT" << setw(14) << "round trip" << endl;
+    for (size_t n : {1, 2, 4, 8, 32, 128, 512, 2048}) {
+        double dft = dftError(n, rng);
+        double trip = roundTripError(n, rng);
+        ok = ok && dft < 1e-9 * n && trip < 1e-12 * n;
+        cout << setw(8) << n << scientific << setprecision(2) << setw(14) << dft << setw(14) << trip << defaultfloat << endl;
+    }
+
+    cout << "Product of two degree n-1 polynomials: time per call, max error vs naive" << endl;
+    cout << setw(8) << "n" << setw(14) << "naive ms" << setw(14) << "fft ms" << setw(14) << "scalar ms"
+         << setw(14) << "max error" << endl;
+    for (int log = 4; log <= maxLog; ++log) {
+        size_t n = size_t(1) << log;
+        ComplexPolynomial<double> p = generate(n, rng), q = generate(n, rng);
+        ComplexPolynomial<double> fast = multiplyFFT(p, q);
+        ComplexPolynomial<double> scalar = multiplyFFT(p, q, false);
+        double fastMs = timeIt([&] { fast = multiplyFFT(p, q); }) * 1e3;
+        double scalarMs = timeIt([&] { scalar = multiplyFFT(p, q, false); }) * 1e3;
+        cout << setw(8) << n;
+        if (log <= 14) { // The schoolbook product takes seconds beyond this
+            ComplexPolynomial<double> naive = multiplyNaive(p, q);
+            double naiveMs = timeIt([&] { naive = multiplyNaive(p, q); }) * 1e3;
+            double error = max(maxDifference(fast, naive), maxDifference(scalar, naive));
+            ok = ok && error <= fftProductErrorBound(p, q) && error < 0.005; // Still rounds to the same two decimals
+            cout << fixed << setprecision(3) << setw(14) << naiveMs << setw(14) << fastMs << setw(14) << scalarMs
+                 << scientific << setprecision(2) << setw(14) << error;
+        } else {
+            cout << fixed << setprecision(3) << setw(14) << "-" << setw(14) << fastMs << setw(14) << scalarMs
+                 << setw(14) << "-";
+        }
+        cout << defaultfloat << endl;
+    }
+    cout << (ok ? "checks passed" : "CHECK FAILED") << endl;
+    return ok ? 0 : 1;
+}
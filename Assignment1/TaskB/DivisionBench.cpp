@@ -0,0 +1,110 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "ComplexDivision.h"
+
+using namespace std;
+
+// Micro-benchmark and accuracy report for the Complex division algorithms.
+// Usage: DivisionBench [count]. Accuracy is measured in ulps against a long double
+// evaluation of the textbook formula, whose wider exponent range cannot overflow here.
+
+struct Operands {
+    vector<double> a, b, c, d;
+};
+
+// Draws count operand sets with magnitudes 10^[minExp, maxExp] and random signs
+Operands generate(size_t count, double minExp, double maxExp, mt19937_64& rng) {
+    uniform_real_distribution<double> exponent(minExp, maxExp);
+    uniform_int_distribution<int> sign(0, 1);
+    auto draw = [&] { return (sign(rng) ? -1.0 : 1.0) * pow(10.0, exponent(rng)); };
+    Operands ops;
+    for (size_t i = 0; i < count; ++i) {
+        ops.a.push_back(draw());
+        ops.b.push_back(draw());
+        ops.c.push_back(draw());
+        ops.d.push_back(draw());
+    }
+    return ops;
+}
+
+// Distance in ulps between a computed double and the long double reference
+double ulpError(double computed, long double reference) {
+    if (!isfinite(computed)) {
+        return INFINITY;
+    }
+    double rounded = (double)reference;
+    double ulp = nextafter(fabs(rounded), INFINITY) - fabs(rounded);
+    if (ulp == 0 || !isfinite(ulp)) {
+        return computed == rounded ? 0 : INFINITY;
+    }
+    return (double)(fabsl((long double)computed - reference) / ulp);
+}
+
+void reportAccuracy(const string& regime, const Operands& ops) {
+    const DivisionAlgorithm algorithms[] = {DivisionAlgorithm::Naive, DivisionAlgorithm::Reciprocal,
+                                            DivisionAlgorithm::Smith, DivisionAlgorithm::Baudin};
+    const char* names[] = {"naive", "reciprocal", "smith", "baudin"};
+    for (int k = 0; k < 4; ++k) {
+        double maxError = 0, totalError = 0;
+        size_t failures = 0, finite = 0;
+        for (size_t i = 0; i < ops.a.size(); ++i) {
+            long double a = ops.a[i], b = ops.b[i], c = ops.c[i], d = ops.d[i];
+            long double denominator = c * c + d * d;
+            long double re = (a * c + b * d) / denominator;
+            long double im = (b * c - a * d) / denominator;
+            double e, f;
+            divide(algorithms[k], ops.a[i], ops.b[i], ops.c[i], ops.d[i], e, f);
+            double error = max(ulpError(e, re), ulpError(f, im));
+            if (!isfinite(error)) {
+                ++failures;
+                continue;
+            }
+            maxError = max(maxError, error);
+            totalError += error;
+            ++finite;
+        }
+        cout << setw(10) << regime << setw(11) << names[k]
+             << "  max " << setw(12) << maxError << " ulp"
+             << "  mean " << setw(10) << (finite ? totalError / finite : 0) << " ulp"
+             << "  overflow/nan " << failures << endl;
+    }
+}
+
+void benchmark(const Operands& ops) {
+    const DivisionAlgorithm algorithms[] = {DivisionAlgorithm::Naive, DivisionAlgorithm::Reciprocal,
+                                            DivisionAlgorithm::Smith, DivisionAlgorithm::Baudin};
+    const char* names[] = {"naive", "reciprocal", "smith", "baudin"};
+    size_t count = ops.a.size();
+    vector<double> e(count), f(count);
+    for (int k = 0; k < 4; ++k) {
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            divide(algorithms[k], ops.a[i], ops.b[i], ops.c[i], ops.d[i], e[i], f[i]);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double checksum = 0;
+        for (size_t i = 0; i < count; i += 97) {
+            checksum += e[i] + f[i];
+        }
+        cout << setw(11) << names[k] << "  " << setw(8) << count / seconds / 1e6 << " Mdiv/s  (checksum " << checksum << ")" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? stoul(argv[1]) : 1000000;
+    mt19937_64 rng(2024);
+
+    cout << "Throughput on task-range operands (|x| <= 50):" << endl;
+    benchmark(generate(count, -2, 1.7, rng));
+
+    cout << endl << "Accuracy against long double reference:" << endl;
+    reportAccuracy("task", generate(count / 10, -2, 1.7, rng));
+    reportAccuracy("wide", generate(count / 10, -150, 150, rng));
+    reportAccuracy("huge", generate(count / 10, 150, 308, rng));
+    reportAccuracy("tiny", generate(count / 10, -308, -150, rng));
+    return 0;
+}
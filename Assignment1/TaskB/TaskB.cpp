@@ -2,49 +2,74 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <string>
+#include "ComplexBatch.h"
+#include "ComplexDivision.h"
+#include "ComplexEquality.h"
+#include "ComplexFFT.h"
+#include "ComplexSet.h"
+#include "../../Common/FastInput.h"
+#include "../../Common/FastOutput.h"
 
 using namespace std;
 
-// Define a class for complex numbers
+// Define a class template for complex numbers over float, double or long double.
+// All operators are constexpr, so expressions on constant operands fold at compile time.
+template<typename T>
 class Complex {
 private:
-    double real; // Real part of the complex number
-    double imaginary; // Imaginary part of the complex number
+    T real; // Real part of the complex number
+    T imaginary; // Imaginary part of the complex number
 
 public:
+    // Division algorithm used by operator/ at run time, selected once per run with --div=
+    static inline DivisionAlgorithm divisionAlgorithm = DivisionAlgorithm::Naive;
+
+    // Comparison used by operator== at run time, selected once per run with --eq=
+    static inline EqualitySettings equality;
+
     // Constructor to initialize the real and imaginary parts
-    Complex(double r, double i) : real(r), imaginary(i) {}
+    constexpr Complex(T r, T i) noexcept : real(r), imaginary(i) {}
 
     // Overload the addition operator (+) for complex numbers
-    Complex operator+(const Complex& other) const {
+    constexpr Complex operator+(const Complex& other) const noexcept {
         return Complex(real + other.real, imaginary + other.imaginary);
     }
 
     // Overload the subtraction operator (-) for complex numbers
-    Complex operator-(const Complex& other) const {
+    constexpr Complex operator-(const Complex& other) const noexcept {
         return Complex(real - other.real, imaginary - other.imaginary);
     }
 
     // Overload the multiplication operator (*) for complex numbers
-    Complex operator*(const Complex& other) const {
+    constexpr Complex operator*(const Complex& other) const noexcept {
         return Complex(real * other.real - imaginary * other.imaginary,
                        real * other.imaginary + imaginary * other.real);
     }
 
-    // Overload the division operator (/) for complex numbers
-    Complex operator/(const Complex& other) const {
-        double denominator = other.real * other.real + other.imaginary * other.imaginary;
-        return Complex((real * other.real + imaginary * other.imaginary) / denominator,
-                       (imaginary * other.real - real * other.imaginary) / denominator);
+    // Overload the division operator (/) for complex numbers; constant evaluation
+    // always uses the naive formula since the run-time selection isn't known yet
+    constexpr Complex operator/(const Complex& other) const noexcept {
+        T e{}, f{};
+        if (is_constant_evaluated()) {
+            divideNaive(real, imaginary, other.real, other.imaginary, e, f);
+        } else {
+            divide(divisionAlgorithm, real, imaginary, other.real, other.imaginary, e, f);
+        }
+        return Complex(e, f);
     }
 
-    // Overload the equality operator (==) for complex numbers
-    bool operator==(const Complex& other) const {
-        return (real == other.real) && (imaginary == other.imaginary);
+    // Overload the equality operator (==) for complex numbers; exact during constant
+    // evaluation, otherwise per the selected exact/epsilon/ulp comparison
+    constexpr bool operator==(const Complex& other) const noexcept {
+        if (is_constant_evaluated() || equality.mode == EqualityMode::Exact) {
+            return (real == other.real) && (imaginary == other.imaginary);
+        }
+        return partsEqual(real, other.real, equality) && partsEqual(imaginary, other.imaginary, equality);
     }
 
     // Overload the inequality operator (!=) for complex numbers
-    bool operator!=(const Complex& other) const {
+    constexpr bool operator!=(const Complex& other) const noexcept {
         return !(*this == other);
     }
 
@@ -56,21 +81,73 @@ public:
         out << fixed << setprecision(2) << c.imaginary << "i"; // Output imaginary part with 2 decimal places and "i"
         return out;
     }
+
+    // Same "a+bi" form as operator<< above, formatted by hand without stream state
+    friend FastOutput& operator<<(FastOutput& out, const Complex& c) {
+        out.writeFixed(c.real, 2);
+        if (c.imaginary >= 0)
+            out << '+';
+        out.writeFixed(c.imaginary, 2) << 'i';
+        return out;
+    }
 };
 
-int main() {
+// Compile-time checks: these fold away entirely
+static_assert(Complex<double>(1, 2) * Complex<double>(3, 4) == Complex<double>(-5, 10));
+static_assert(Complex<float>(-5, 10) / Complex<float>(3, 4) == Complex<float>(1, 2));
+static_assert(Complex<long double>(1, 2) + Complex<long double>(3, 4) != Complex<long double>(4, 5));
+
+// Batch kernel for '=' under a tolerant comparison: defers to Complex<T>::operator==
+template<typename T>
+void eqTolerant(const T* a, const T* b, const T* c, const T* d, T* re, T* im, size_t first, size_t count) {
+    for (size_t i = first; i < count; ++i) {
+        re[i] = Complex<T>(a[i], b[i]) == Complex<T>(c[i], d[i]) ? T(1) : T(0);
+        im[i] = T(0);
+    }
+}
+
+// Function to load all n lines into SoA groups, run the vector kernels, then print in order
+template<typename T>
+void processBatch(FastOutput& out, bool useSimd) {
+    FastInput in;
+    int n = in.readInt();
+    ComplexBatch<T> batch(useSimd, Complex<T>::divisionAlgorithm);
+    if (Complex<T>::equality.mode != EqualityMode::Exact) {
+        batch.setKernel('=', eqTolerant<T>);
+    }
+    for (int i = 0; i < n; ++i) {
+        string_view op = in.readToken();
+        T a = in.readReal<T>();
+        T b = in.readReal<T>();
+        T c = in.readReal<T>();
+        T d = in.readReal<T>();
+        batch.push(op.empty() ? '\0' : op[0], a, b, c, d);
+    }
+    batch.run();
+    batch.forEachResult([&](char op, T re, T im) {
+        if (op == '=') {
+            out << (re != T(0) ? "true\n" : "false\n");
+        } else {
+            out << Complex<T>(re, im) << '\n';
+        }
+    });
+}
+
+// Function to evaluate the lines one at a time from cin
+template<typename T>
+void processStream(FastOutput& out) {
     int n;
     cin >> n;
 
     // Iterate through each operation
     for (int i = 0; i < n; ++i) {
         char op;
-        double a, b, c, d;
+        T a, b, c, d;
         cin >> op >> a >> b >> c >> d; // Read the operation and complex numbers
 
-        Complex num1(a, b); // Create first complex number
-        Complex num2(c, d); // Create second complex number
-        Complex result(0, 0); // Initialize result complex number
+        Complex<T> num1(a, b); // Create first complex number
+        Complex<T> num2(c, d); // Create second complex number
+        Complex<T> result(0, 0); // Initialize result complex number
 
         switch (op) {
             case '+': // Addition operation
@@ -86,11 +163,130 @@ int main() {
                 result = num1 / num2;
                 break;
             case '=': // Equality check
-                cout << (num1 == num2 ? "true" : "false") << endl; // Output true if equal, otherwise false
+                out << (num1 == num2 ? "true\n" : "false\n"); // Output true if equal, otherwise false
                 continue; // Skip the rest of the loop
         }
 
-        cout << result << endl; // Output the result of the operation
+        out << result << '\n'; // Output the result of the operation
+    }
+}
+
+// Function to deduplicate a stream of n "a b" values in linear expected time: prints
+// every first occurrence (unique) or only how many distinct values there were
+template<typename T>
+void processDistinct(FastOutput& out, bool printUnique) {
+    FastInput in;
+    int n = in.readInt();
+    ComplexSet<T> seen(Complex<T>::equality, n);
+    for (int i = 0; i < n; ++i) {
+        T a = in.readReal<T>();
+        T b = in.readReal<T>();
+        if (seen.insert(a, b) && printUnique) {
+            out << Complex<T>(a, b) << '\n';
+        }
+    }
+    if (!printUnique) {
+        out << seen.size() << '\n';
+    }
+}
+
+// Below this many coefficients in the shorter polynomial the schoolbook product is cheaper
+constexpr size_t naiveConvolutionLimit = 32;
+
+// Function to multiply two polynomials given as "n m", then n "a b" and m "c d" coefficient
+// lines, lowest degree first; prints the n + m - 1 product coefficients
+template<typename T>
+void processConvolution(FastOutput& out, bool useSimd) {
+    FastInput in;
+    int n = in.readInt();
+    int m = in.readInt();
+    auto readPolynomial = [&in](int count) {
+        ComplexPolynomial<T> poly;
+        for (int i = 0; i < count; ++i) {
+            poly.re.push_back(in.readReal<T>());
+            poly.im.push_back(in.readReal<T>());
+        }
+        return poly;
+    };
+    ComplexPolynomial<T> p = readPolynomial(n);
+    ComplexPolynomial<T> q = readPolynomial(m);
+    if (min(p.size(), q.size()) <= naiveConvolutionLimit) {
+        ComplexPolynomial<T> product = multiplyNaive(p, q);
+        for (size_t k = 0; k < product.size(); ++k) {
+            out << Complex<T>(product.re[k], product.im[k]) << '\n';
+        }
+        return;
+    }
+    // A coefficient within the FFT's error bound of 0 is 0 up to rounding noise; print it as
+    // 0.00 rather than as whatever sign the noise had
+    ComplexPolynomial<T> product = multiplyFFT(p, q, useSimd);
+    T noise = fftProductErrorBound(p, q);
+    auto snap = [noise](T x) { return fabs(x) <= noise ? T(0) : x; };
+    for (size_t k = 0; k < product.size(); ++k) {
+        out << Complex<T>(snap(product.re[k]), snap(product.im[k])) << '\n';
+    }
+}
+
+// Function to run the selected engine at precision T
+template<typename T>
+void run(FastOutput& out, const string& mode, bool useSimd, DivisionAlgorithm division, const EqualitySettings& equality) {
+    Complex<T>::divisionAlgorithm = division;
+    Complex<T>::equality = equality;
+    if (mode == "batch") {
+        processBatch<T>(out, useSimd);
+    } else if (mode == "unique" || mode == "count-distinct") {
+        processDistinct<T>(out, mode == "unique");
+    } else if (mode == "conv") {
+        processConvolution<T>(out, useSimd);
+    } else {
+        processStream<T>(out);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Engine selection: --batch groups lines by opcode and runs SIMD kernels,
+    // --batch --scalar uses the same grouping with the scalar kernels
+    // Division algorithm: --div=naive|reciprocal|smith|baudin
+    // Arithmetic precision: --precision=float|double|long-double
+    // Comparison for '=' and dedupe: --eq=exact|eps:<tolerance>|ulp:<count>
+    // Dedupe modes over n "a b" lines: --unique prints first occurrences, --count-distinct the count
+    // Polynomial product: --conv reads "n m" and the n + m coefficient lines; FFT unless one side is tiny
+    string mode = "stream";
+    bool useSimd = true;
+    DivisionAlgorithm division = DivisionAlgorithm::Naive;
+    EqualitySettings equality;
+    string precision = "double";
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--batch" || arg == "--unique" || arg == "--count-distinct" || arg == "--conv") {
+            mode = arg.substr(2);
+        } else if (arg.rfind("--eq=", 0) == 0) {
+            if (!parseEqualitySettings(arg.substr(5), equality)) {
+                cerr << "Error: Invalid comparison " << arg.substr(5) << "." << endl;
+                return 1;
+            }
+        } else if (arg == "--scalar") {
+            useSimd = false;
+        } else if (arg.rfind("--div=", 0) == 0) {
+            if (!parseDivisionAlgorithm(arg.substr(6), division)) {
+                cerr << "Error: Unknown division algorithm " << arg.substr(6) << "." << endl;
+                return 1;
+            }
+        } else if (arg.rfind("--precision=", 0) == 0) {
+            precision = arg.substr(12);
+        }
+    }
+
+    FastOutput out;
+    if (precision == "float") {
+        run<float>(out, mode, useSimd, division, equality);
+    } else if (precision == "double") {
+        run<double>(out, mode, useSimd, division, equality);
+    } else if (precision == "long-double") {
+        run<long double>(out, mode, useSimd, division, equality);
+    } else {
+        cerr << "Error: Unknown precision " << precision << "." << endl;
+        return 1;
     }
 
     return 0;
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// B+-tree multiset with wide nodes. Keys live only in the leaves, which are chained left to
+// right for ordered iteration; inner nodes hold separators plus the element count under each
+// child, so search, rank and range-count are all one root-to-leaf descent: O(log n).
+// Nodes sit in two index-addressed pools, which keeps them contiguous and reuses freed slots.
+template<typename T>
+class BPlusTree {
+private:
+    static constexpr int leafCapacity = 64;  // Keys per leaf
+    static constexpr int innerCapacity = 64; // Children per inner node
+
+    struct Leaf {
+        int count = 0;
+        int next = -1;            // Leaf to the right, -1 for the last one
+        T keys[leafCapacity + 1]; // One slot of slack for the insert that triggers a split
+    };
+
+    // Child i holds keys <= keys[i] and child i + 1 holds keys >= keys[i]
+    struct Inner {
+        int count = 0;                   // Number of children
+        T keys[innerCapacity];           // count - 1 separators, plus slack
+        int children[innerCapacity + 1];
+        size_t sizes[innerCapacity + 1]; // Elements under each child
+    };
+
+    // What a child reports back to its parent after an insert
+    struct Split {
+        bool happened = false;
+        T separator{};
+        int right = -1;
+        size_t leftSize = 0;
+        size_t rightSize = 0;
+    };
+
+    std::vector<Leaf> leaves;
+    std::vector<Inner> inners;
+    std::vector<int> freeLeaves;
+    std::vector<int> freeInners;
+    int root = 0;   // Leaf or inner node index depending on height
+    int height = 0; // 0 while the root is a leaf
+    int first = 0;  // Leftmost leaf
+    size_t total = 0;
+
+    int newLeaf() {
+        if (!freeLeaves.empty()) {
+            int id = freeLeaves.back();
+            freeLeaves.pop_back();
+            leaves[id] = Leaf{};
+            return id;
+        }
+        leaves.emplace_back();
+        return (int)leaves.size() - 1;
+    }
+
+    int newInner() {
+        if (!freeInners.empty()) {
+            int id = freeInners.back();
+            freeInners.pop_back();
+            inners[id] = Inner{};
+            return id;
+        }
+        inners.emplace_back();
+        return (int)inners.size() - 1;
+    }
+
+    // Inserts x under node (level 0 is a leaf); node references are re-fetched after
+    // each allocation because the pools may reallocate
+    Split insertInto(int node, int level, const T& x) {
+        if (level == 0) {
+            Leaf& leaf = leaves[node];
+            T* position = std::upper_bound(leaf.keys, leaf.keys + leaf.count, x);
+            std::copy_backward(position, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+            *position = x;
+            if (++leaf.count <= leafCapacity) {
+                return Split{};
+            }
+            int right = newLeaf();
+            Leaf& left = leaves[node];
+            Leaf& sibling = leaves[right];
+            int half = left.count / 2;
+            sibling.count = left.count - half;
+            std::copy(left.keys + half, left.keys + left.count, sibling.keys);
+            left.count = half;
+            sibling.next = left.next;
+            left.next = right;
+            return Split{true, sibling.keys[0], right, (size_t)left.count, (size_t)sibling.count};
+        }
+
+        Inner& parent = inners[node];
+        int j = std::upper_bound(parent.keys, parent.keys + parent.count - 1, x) - parent.keys;
+        ++parent.sizes[j];
+        Split split = insertInto(parent.children[j], level - 1, x);
+        if (!split.happened) {
+            return Split{};
+        }
+
+        Inner& grown = inners[node];
+        std::copy_backward(grown.keys + j, grown.keys + grown.count - 1, grown.keys + grown.count);
+        std::copy_backward(grown.children + j + 1, grown.children + grown.count, grown.children + grown.count + 1);
+        std::copy_backward(grown.sizes + j + 1, grown.sizes + grown.count, grown.sizes + grown.count + 1);
+        grown.keys[j] = split.separator;
+        grown.children[j + 1] = split.right;
+        grown.sizes[j] = split.leftSize;
+        grown.sizes[j + 1] = split.rightSize;
+        if (++grown.count <= innerCapacity) {
+            return Split{};
+        }
+
+        int right = newInner();
+        Inner& left = inners[node];
+        Inner& sibling = inners[right];
+        int half = left.count / 2;
+        sibling.count = left.count - half;
+        std::copy(left.keys + half, left.keys + left.count - 1, sibling.keys);
+        std::copy(left.children + half, left.children + left.count, sibling.children);
+        std::copy(left.sizes + half, left.sizes + left.count, sibling.sizes);
+        T separator = left.keys[half - 1];
+        left.count = half;
+        size_t leftSize = 0, rightSize = 0;
+        for (int i = 0; i < left.count; ++i) leftSize += left.sizes[i];
+        for (int i = 0; i < sibling.count; ++i) rightSize += sibling.sizes[i];
+        return Split{true, separator, right, leftSize, rightSize};
+    }
+
+    // Number of elements < x (orEqual: <= x)
+    size_t rank(const T& x, bool orEqual) const {
+        size_t below = 0;
+        int node = root;
+        for (int level = height; level > 0; --level) {
+            const Inner& inner = inners[node];
+            const T* end = inner.keys + inner.count - 1;
+            int j = (orEqual ? std::upper_bound(inner.keys, end, x) : std::lower_bound(inner.keys, end, x)) - inner.keys;
+            for (int i = 0; i < j; ++i) {
+                below += inner.sizes[i];
+            }
+            node = inner.children[j];
+        }
+        const Leaf& leaf = leaves[node];
+        const T* end = leaf.keys + leaf.count;
+        return below + ((orEqual ? std::upper_bound(leaf.keys, end, x) : std::lower_bound(leaf.keys, end, x)) - leaf.keys);
+    }
+
+    int rightmostLeaf() const {
+        int node = root;
+        for (int level = height; level > 0; --level) {
+            node = inners[node].children[inners[node].count - 1];
+        }
+        return node;
+    }
+
+public:
+    // Forward iterator over the leaf chain in ascending order
+    class const_iterator {
+    private:
+        const BPlusTree* tree;
+        int leaf;
+        int position;
+
+    public:
+        const_iterator(const BPlusTree* tree, int leaf, int position) : tree(tree), leaf(leaf), position(position) {}
+        const T& operator*() const { return tree->leaves[leaf].keys[position]; }
+        const_iterator& operator++() {
+            if (++position == tree->leaves[leaf].count) {
+                leaf = tree->leaves[leaf].next;
+                position = 0;
+            }
+            return *this;
+        }
+        bool operator!=(const const_iterator& other) const { return leaf != other.leaf || position != other.position; }
+        bool operator==(const const_iterator& other) const { return !(*this != other); }
+    };
+
+    BPlusTree() { clear(); }
+
+    void insert(const T& x) {
+        Split split = insertInto(root, height, x);
+        ++total;
+        if (split.happened) {
+            int top = newInner();
+            Inner& inner = inners[top];
+            inner.count = 2;
+            inner.keys[0] = split.separator;
+            inner.children[0] = root;
+            inner.children[1] = split.right;
+            inner.sizes[0] = split.leftSize;
+            inner.sizes[1] = split.rightSize;
+            root = top;
+            ++height;
+        }
+    }
+
+    void insert(const T& x, size_t times) {
+        for (size_t i = 0; i < times; ++i) {
+            insert(x);
+        }
+    }
+
+    bool contains(const T& x) const {
+        int node = root;
+        for (int level = height; level > 0; --level) {
+            const Inner& inner = inners[node];
+            node = inner.children[std::lower_bound(inner.keys, inner.keys + inner.count - 1, x) - inner.keys];
+        }
+        // Every element >= x is in this leaf or further right, and only the root leaf is ever empty
+        const Leaf& leaf = leaves[node];
+        const T* position = std::lower_bound(leaf.keys, leaf.keys + leaf.count, x);
+        if (position != leaf.keys + leaf.count) {
+            return !(x < *position);
+        }
+        return leaf.next >= 0 && !(x < leaves[leaf.next].keys[0]);
+    }
+
+    // Number of elements in [lo, hi]
+    size_t countRange(const T& lo, const T& hi) const {
+        return hi < lo ? 0 : rank(hi, true) - rank(lo, false);
+    }
+
+    // Removes one copy of the largest element, if any. Leaves only empty from the right,
+    // so an emptied leaf is unlinked rather than rebalanced with a sibling.
+    void eraseMax() {
+        if (total == 0) {
+            return;
+        }
+        if (--total == 0) {
+            clear();
+            return;
+        }
+        std::vector<int> path; // Inner nodes on the rightmost path
+        int node = root;
+        for (int level = height; level > 0; --level) {
+            Inner& inner = inners[node];
+            --inner.sizes[inner.count - 1];
+            path.push_back(node);
+            node = inner.children[inner.count - 1];
+        }
+        if (--leaves[node].count > 0) {
+            return;
+        }
+
+        freeLeaves.push_back(node);
+        while (!path.empty()) {
+            Inner& parent = inners[path.back()];
+            if (--parent.count > 0) {
+                break;
+            }
+            freeInners.push_back(path.back());
+            path.pop_back();
+        }
+        // Collapse single-child roots, then terminate the leaf chain at the new last leaf
+        while (height > 0 && inners[root].count == 1) {
+            freeInners.push_back(root);
+            root = inners[root].children[0];
+            --height;
+        }
+        leaves[rightmostLeaf()].next = -1;
+    }
+
+    // Keeps the n smallest elements
+    void truncate(size_t n) {
+        while (total > n) {
+            eraseMax();
+        }
+    }
+
+    void clear() {
+        leaves.assign(1, Leaf{});
+        inners.clear();
+        freeLeaves.clear();
+        freeInners.clear();
+        root = 0;
+        height = 0;
+        first = 0;
+        total = 0;
+    }
+
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+
+    const_iterator begin() const { return total ? const_iterator(this, first, 0) : end(); }
+    const_iterator end() const { return const_iterator(this, -1, 0); }
+};
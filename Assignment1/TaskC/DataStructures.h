@@ -0,0 +1,291 @@
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <ostream>
+#include "BPlusTree.h"
+#include "HashIndex.h"
+#include "SortedVector.h"
+#include "Storage.h"
+#include "../../Common/FastOutput.h"
+
+// Abstract base class for data structures
+class DataStructure {
+public:
+    // Pure virtual functions for common operations
+    virtual void insert(int x) = 0;
+    virtual void remove() = 0;
+    virtual bool search(int x) = 0;
+    virtual ~DataStructure() {} // Virtual destructor
+};
+
+// Abstract class for sequential data structures, inheriting from DataStructure
+class SequentialDataStructure : public virtual DataStructure {
+public:
+    // Pure virtual functions for sequential operations
+    virtual void pushBack(int x) = 0;
+    virtual void pushFront(int x) = 0;
+    virtual void popBack() = 0;
+    virtual void popFront() = 0;
+    virtual ~SequentialDataStructure() {} // Virtual destructor
+};
+
+// Abstract class for dynamic data structures, inheriting from DataStructure
+class DynamicDataStructure : public virtual DataStructure {
+public:
+    // Pure virtual functions for dynamic operations
+    virtual void resize(int new_size) = 0;
+    virtual void clear() = 0;
+    virtual ~DynamicDataStructure() {} // Virtual destructor
+};
+
+// Compile-time counterparts of the three abstract classes above: the same operation
+// sets, checked by concepts instead of dispatched through vtables
+template<typename T>
+concept DataStructureOps = requires(T ds, int x) {
+    ds.insert(x);
+    ds.remove();
+    { ds.search(x) } -> std::convertible_to<bool>;
+};
+
+template<typename T>
+concept SequentialDataStructureOps = DataStructureOps<T> && requires(T ds, int x) {
+    ds.pushBack(x);
+    ds.pushFront(x);
+    ds.popBack();
+    ds.popFront();
+};
+
+template<typename T>
+concept DynamicDataStructureOps = DataStructureOps<T> && requires(T ds, int x) {
+    ds.resize(x);
+    ds.clear();
+};
+
+// Statically dispatched list: no virtual functions, so every call can be inlined.
+// Storage picks the element layout: VectorStorage (the original vector) or RingBuffer (O(1) at both ends).
+// An optional per-instance HashIndex of value -> count turns search into an O(1) expected lookup.
+template<typename Storage>
+class StaticList {
+private:
+    Storage elements; // Storage backend holding the elements
+    std::unique_ptr<HashIndex> index; // Side index for search, null while disabled
+
+public:
+    // Turns the search index on (built from the current elements) or off (memory released)
+    void setIndexed(bool enabled) {
+        if (!enabled) {
+            index.reset();
+        } else if (!index) {
+            index = std::make_unique<HashIndex>();
+            for (int element : elements) {
+                index->add(element);
+            }
+        }
+    }
+
+    bool isIndexed() const { return index != nullptr; }
+
+    // Heap bytes used by the search index, 0 while disabled
+    size_t indexMemoryBytes() const { return index ? index->memoryBytes() : 0; }
+
+    // Implementation of insert operation
+    void insert(int x) {
+        pushBack(x);
+    }
+
+    // Implementation of remove operation
+    void remove() {
+        popBack();
+    }
+
+    // Implementation of search operation
+    bool search(int x) {
+        if (index) {
+            return index->contains(x);
+        }
+        for (int element : elements) {
+            if (element == x) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Implementation of pushBack operation
+    void pushBack(int x) {
+        elements.pushBack(x);
+        if (index) index->add(x);
+    }
+
+    // Implementation of pushFront operation
+    void pushFront(int x) {
+        elements.pushFront(x);
+        if (index) index->add(x);
+    }
+
+    // Implementation of popBack operation
+    void popBack() {
+        if (!elements.empty()) {
+            if (index) index->removeOne(elements.back());
+            elements.popBack();
+        }
+    }
+
+    // Implementation of popFront operation
+    void popFront() {
+        if (!elements.empty()) {
+            if (index) index->removeOne(elements.front());
+            elements.popFront();
+        }
+    }
+
+    // Implementation of resize operation
+    void resize(int new_size) {
+        if (index) {
+            // Dropped tail elements leave the index; new ones are value-initialized zeros
+            for (size_t i = new_size; i < elements.size(); ++i) {
+                index->removeOne(elements[i]);
+            }
+            if ((size_t)new_size > elements.size()) {
+                index->add(0, new_size - (int)elements.size());
+            }
+        }
+        elements.resize(new_size);
+    }
+
+    // Implementation of clear operation
+    void clear() {
+        elements.clear();
+        if (index) index->clear();
+    }
+
+    // Overload the << operator to output the list elements
+    friend std::ostream& operator<<(std::ostream& out, const StaticList& lst) {
+        for (size_t i = 0; i < lst.elements.size(); ++i) {
+            out << lst.elements[i] << " ";
+        }
+        return out;
+    }
+
+    // Same listing as operator<< above, written to the buffered output sink
+    friend FastOutput& operator<<(FastOutput& out, const StaticList& lst) {
+        for (int element : lst.elements) {
+            out << element << ' ';
+        }
+        return out;
+    }
+};
+
+// Statically dispatched sorted list: elements are kept in ascending order, so search and
+// rangeCount are O(log n) and operator<< lists them sorted. remove drops the largest element,
+// the last one in that order. Ordered picks the layout: SortedVector (flat array, batched
+// inserts; best for read-heavy data) or BPlusTree (wide nodes; O(log n) inserts too).
+template<typename Ordered>
+class StaticSortedList {
+private:
+    Ordered elements; // Ordered multiset holding the elements
+
+public:
+    // Implementation of insert operation
+    void insert(int x) {
+        elements.insert(x);
+    }
+
+    // Implementation of remove operation
+    void remove() {
+        elements.eraseMax();
+    }
+
+    // Implementation of search operation
+    bool search(int x) {
+        return elements.contains(x);
+    }
+
+    // Number of elements x with lo <= x <= hi
+    size_t rangeCount(int lo, int hi) const {
+        return elements.countRange(lo, hi);
+    }
+
+    // Implementation of resize operation: keeps the new_size smallest elements, or pads with zeros
+    void resize(int new_size) {
+        if ((size_t)new_size < elements.size()) {
+            elements.truncate(new_size);
+        } else {
+            elements.insert(0, new_size - elements.size());
+        }
+    }
+
+    // Implementation of clear operation
+    void clear() {
+        elements.clear();
+    }
+
+    size_t size() const { return elements.size(); }
+
+    // Overload the << operator to output the elements in ascending order
+    friend std::ostream& operator<<(std::ostream& out, const StaticSortedList& lst) {
+        for (int element : lst.elements) {
+            out << element << " ";
+        }
+        return out;
+    }
+
+    // Same listing as operator<< above, written to the buffered output sink
+    friend FastOutput& operator<<(FastOutput& out, const StaticSortedList& lst) {
+        for (int element : lst.elements) {
+            out << element << ' ';
+        }
+        return out;
+    }
+};
+
+// Concrete class representing a List data structure, inheriting from both SequentialDataStructure and DynamicDataStructure.
+// It adapts a statically dispatched list to the runtime-virtual interface by forwarding each override.
+template<typename Impl>
+    requires SequentialDataStructureOps<Impl> && DynamicDataStructureOps<Impl>
+class VirtualList final : public SequentialDataStructure, public DynamicDataStructure, public Impl {
+public:
+    void insert(int x) override { Impl::insert(x); }
+    void remove() override { Impl::remove(); }
+    bool search(int x) override { return Impl::search(x); }
+    void pushBack(int x) override { Impl::pushBack(x); }
+    void pushFront(int x) override { Impl::pushFront(x); }
+    void popBack() override { Impl::popBack(); }
+    void popFront() override { Impl::popFront(); }
+    void resize(int new_size) override { Impl::resize(new_size); }
+    void clear() override { Impl::clear(); }
+};
+
+// Concrete class representing a sorted data structure, inheriting from DynamicDataStructure.
+// Sorted layouts have no front or back to push to, so they are not sequential.
+template<typename Impl>
+    requires DynamicDataStructureOps<Impl>
+class VirtualSortedList final : public DynamicDataStructure, public Impl {
+public:
+    void insert(int x) override { Impl::insert(x); }
+    void remove() override { Impl::remove(); }
+    bool search(int x) override { return Impl::search(x); }
+    void resize(int new_size) override { Impl::resize(new_size); }
+    void clear() override { Impl::clear(); }
+};
+
+template<typename Storage>
+using BasicList = VirtualList<StaticList<Storage>>;
+
+// The original vector-backed list and the ring-buffer-backed one, behind the virtual interface
+using List = BasicList<VectorStorage<int>>;
+using RingList = BasicList<RingBuffer<int>>;
+
+// The same lists without virtual dispatch
+using StaticVectorList = StaticList<VectorStorage<int>>;
+using StaticRingList = StaticList<RingBuffer<int>>;
+
+// Sorted layouts, with and without virtual dispatch
+using StaticSortedVectorList = StaticSortedList<SortedVector<int>>;
+using StaticBPlusTreeList = StaticSortedList<BPlusTree<int>>;
+using SortedVectorList = VirtualSortedList<StaticSortedVectorList>;
+using BPlusTreeList = VirtualSortedList<StaticBPlusTreeList>;
+
+static_assert(SequentialDataStructureOps<StaticRingList> && DynamicDataStructureOps<StaticRingList>);
+static_assert(DynamicDataStructureOps<StaticBPlusTreeList> && !SequentialDataStructureOps<StaticBPlusTreeList>);
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <vector>
+#include "DataStructures.h"
+
+using namespace std;
+
+// Benchmark: per-operation cost of the same list reached through the virtual
+// DataStructure hierarchy versus the statically dispatched StaticList.
+// Usage: DispatchBench [ops]. Both paths must end with identical contents and search hits.
+
+struct Op {
+    char kind; // 'f' pushFront, 'b' pushBack, 'F' popFront, 'B' popBack, 's' search
+    int x;
+};
+
+vector<Op> makeOps(int ops, unsigned seed) {
+    mt19937 rng(seed);
+    const char kinds[] = {'f', 'b', 'F', 'B', 's', 's', 's', 's'};
+    vector<Op> result(ops);
+    int size = 0;
+    for (Op& op : result) {
+        op.kind = kinds[rng() % 8];
+        op.x = rng() % 1000;
+        if ((op.kind == 'F' || op.kind == 'B') && size == 0) {
+            op.kind = 'b';
+        }
+        size += op.kind == 'f' || op.kind == 'b' ? 1 : (op.kind == 'F' || op.kind == 'B' ? -1 : 0);
+    }
+    return result;
+}
+
+// Drives the list through the abstract interfaces; noinline keeps the compiler from
+// seeing the concrete type and devirtualizing the calls
+__attribute__((noinline)) long long runVirtual(SequentialDataStructure& list, const vector<Op>& ops) {
+    long long hits = 0;
+    for (const Op& op : ops) {
+        switch (op.kind) {
+            case 'f': list.pushFront(op.x); break;
+            case 'b': list.pushBack(op.x); break;
+            case 'F': list.popFront(); break;
+            case 'B': list.popBack(); break;
+            case 's': hits += list.search(op.x); break;
+        }
+    }
+    return hits;
+}
+
+template<SequentialDataStructureOps ListType>
+__attribute__((noinline)) long long runStatic(ListType& list, const vector<Op>& ops) {
+    long long hits = 0;
+    for (const Op& op : ops) {
+        switch (op.kind) {
+            case 'f': list.pushFront(op.x); break;
+            case 'b': list.pushBack(op.x); break;
+            case 'F': list.popFront(); break;
+            case 'B': list.popBack(); break;
+            case 's': hits += list.search(op.x); break;
+        }
+    }
+    return hits;
+}
+
+template<typename VirtualType, typename StaticType>
+void compare(const string& name, const vector<Op>& ops) {
+    VirtualType virtualList;
+    StaticType staticList;
+    virtualList.setIndexed(true); // Keep search O(1) so the call overhead is what gets measured
+    staticList.setIndexed(true);
+
+    auto start = chrono::steady_clock::now();
+    long long virtualHits = runVirtual(virtualList, ops);
+    double virtualSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    long long staticHits = runStatic(staticList, ops);
+    double staticSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    ostringstream virtualContents, staticContents;
+    virtualContents << virtualList;
+    staticContents << staticList;
+    bool same = virtualHits == staticHits && virtualContents.str() == staticContents.str();
+    cout << setw(8) << left << name << right << fixed << setprecision(2)
+         << " virtual " << setw(7) << virtualSeconds * 1e9 / ops.size() << " ns/op"
+         << "   static " << setw(7) << staticSeconds * 1e9 / ops.size() << " ns/op"
+         << (same ? "" : "   MISMATCH") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? stoi(argv[1]) : 5000000;
+    vector<Op> workload = makeOps(ops, 7);
+
+    cout << "ops: " << ops << endl;
+    compare<RingList, StaticRingList>("ring", workload);
+    compare<List, StaticVectorList>("vector", workload);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash multiset of int -> occurrence count. Linear probing over a
+// power-of-two table kept at most half full; erasing uses backward-shift deletion,
+// so there are no tombstones and probe chains stay short under churn.
+class HashIndex {
+private:
+    struct Slot {
+        int key;
+        int count = 0; // 0 marks an empty slot
+    };
+
+    std::vector<Slot> slots;
+    size_t distinct = 0;
+
+    static size_t hash(int key) {
+        uint64_t x = static_cast<uint32_t>(key);
+        x *= 0x9e3779b97f4a7c15ULL; // Fibonacci hashing; the high bits are well mixed
+        return static_cast<size_t>(x >> 32);
+    }
+
+    size_t mask() const { return slots.size() - 1; }
+
+    // Slot holding key, or the empty slot where it would go
+    size_t find(int key) const {
+        size_t i = hash(key) & mask();
+        while (slots[i].count && slots[i].key != key) {
+            i = (i + 1) & mask();
+        }
+        return i;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(slots);
+        for (const Slot& slot : old) {
+            if (slot.count) {
+                slots[find(slot.key)] = slot;
+            }
+        }
+    }
+
+public:
+    HashIndex() : slots(16) {}
+
+    // Adds times occurrences of key
+    void add(int key, int times = 1) {
+        if ((distinct + 1) * 2 > slots.size()) {
+            rehash(slots.size() * 2);
+        }
+        size_t i = find(key);
+        if (!slots[i].count) {
+            slots[i].key = key;
+            ++distinct;
+        }
+        slots[i].count += times;
+    }
+
+    // Removes one occurrence of key, if present
+    void removeOne(int key) {
+        size_t i = find(key);
+        if (!slots[i].count) {
+            return;
+        }
+        if (--slots[i].count) {
+            return;
+        }
+        --distinct;
+        // Backward-shift: pull later chain members into the hole when it's on their probe path
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask(); slots[j].count; j = (j + 1) & mask()) {
+            size_t home = hash(slots[j].key) & mask();
+            if (((j - home) & mask()) >= ((j - hole) & mask())) {
+                slots[hole] = slots[j];
+                slots[j].count = 0;
+                hole = j;
+            }
+        }
+    }
+
+    bool contains(int key) const {
+        return slots[find(key)].count != 0;
+    }
+
+    int count(int key) const {
+        return slots[find(key)].count;
+    }
+
+    void clear() {
+        slots.assign(16, Slot{});
+        distinct = 0;
+    }
+
+    size_t distinctKeys() const { return distinct; }
+
+    // Heap bytes held by the table
+    size_t memoryBytes() const { return slots.capacity() * sizeof(Slot); }
+};
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <functional>
+#include "DataStructures.h"
+
+using namespace std;
+
+// Benchmark: vector-backed List against ring-buffer-backed RingList on front/back workloads.
+// Usage: ListBench [ops]. Both lists must end with identical contents.
+
+// Applies ops random operations; frontShare is the probability an op targets the front
+template<typename ListType>
+string runWorkload(ListType& list, int ops, double frontShare, double popShare, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> coin(0, 1);
+    for (int i = 0; i < ops; ++i) {
+        bool front = coin(rng) < frontShare;
+        bool pop = coin(rng) < popShare;
+        int x = rng() % 1000;
+        if (front) {
+            pop ? list.popFront() : list.pushFront(x);
+        } else {
+            pop ? list.popBack() : list.pushBack(x);
+        }
+    }
+    ostringstream contents;
+    contents << list;
+    return contents.str();
+}
+
+struct Workload {
+    string name;
+    double frontShare;
+    double popShare;
+};
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? stoi(argv[1]) : 200000;
+    Workload workloads[] = {
+        {"stack (back only)", 0.0, 0.4},
+        {"queue-ish (50% front)", 0.5, 0.4},
+        {"front-heavy (90% front)", 0.9, 0.4},
+        {"front only", 1.0, 0.4},
+    };
+
+    cout << "ops per workload: " << ops << endl;
+    for (const Workload& w : workloads) {
+        double seconds[2];
+        string contents[2];
+        for (int k = 0; k < 2; ++k) {
+            auto start = chrono::steady_clock::now();
+            if (k == 0) {
+                List list;
+                contents[k] = runWorkload(list, ops, w.frontShare, w.popShare, 7);
+            } else {
+                RingList list;
+                contents[k] = runWorkload(list, ops, w.frontShare, w.popShare, 7);
+            }
+            seconds[k] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+        cout << setw(26) << left << w.name << right
+             << " vector " << setw(10) << seconds[0] * 1e3 << " ms"
+             << "   ring " << setw(10) << seconds[1] * 1e3 << " ms"
+             << (contents[0] == contents[1] ? "" : "   MISMATCH") << endl;
+    }
+    return 0;
+}
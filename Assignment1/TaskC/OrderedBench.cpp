@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include "DataStructures.h"
+
+using namespace std;
+
+// Benchmark: flat sorted vector against B+-tree across read/write mixes.
+// Usage: OrderedBench [ops]. Both layouts must agree on every answer and the final contents.
+
+// Applies ops random operations: insertShare inserts, removeShare removes of the largest,
+// the rest split evenly between search and rangeCount. Returns a checksum of the answers.
+template<typename ListType>
+long long runWorkload(ListType& list, int ops, double insertShare, double removeShare, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> coin(0, 1);
+    long long checksum = 0;
+    for (int i = 0; i < ops; ++i) {
+        double kind = coin(rng);
+        int x = rng() % 1000000;
+        if (kind < insertShare) {
+            list.insert(x);
+        } else if (kind < insertShare + removeShare) {
+            list.remove();
+        } else if (rng() % 2) {
+            checksum += list.search(x);
+        } else {
+            checksum = checksum * 31 + list.rangeCount(x, x + 5000);
+        }
+    }
+    return checksum;
+}
+
+struct Workload {
+    string name;
+    double insertShare;
+    double removeShare;
+};
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? stoi(argv[1]) : 500000;
+    Workload workloads[] = {
+        {"write-heavy (90% insert)", 0.9, 0.05},
+        {"balanced (50% insert)", 0.5, 0.1},
+        {"read-heavy (10% insert)", 0.1, 0.02},
+    };
+
+    cout << "ops per workload: " << ops << endl;
+    for (const Workload& w : workloads) {
+        double seconds[2];
+        long long checksums[2] = {0, 0};
+        string contents[2];
+        for (int k = 0; k < 2; ++k) {
+            ostringstream listing;
+            auto start = chrono::steady_clock::now();
+            if (k == 0) {
+                StaticSortedVectorList list;
+                checksums[k] = runWorkload(list, ops, w.insertShare, w.removeShare, 7);
+                listing << list;
+            } else {
+                StaticBPlusTreeList list;
+                checksums[k] = runWorkload(list, ops, w.insertShare, w.removeShare, 7);
+                listing << list;
+            }
+            seconds[k] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            contents[k] = listing.str();
+        }
+        cout << setw(26) << left << w.name << right
+             << " sorted " << setw(10) << seconds[0] * 1e3 << " ms"
+             << "   btree " << setw(10) << seconds[1] * 1e3 << " ms"
+             << (checksums[0] == checksums[1] && contents[0] == contents[1] ? "" : "   MISMATCH") << endl;
+    }
+    return 0;
+}
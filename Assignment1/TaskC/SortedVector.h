@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Flat sorted multiset: one contiguous sorted array, binary-searched on lookups.
+// Inserts are batched in a small unsorted buffer and merged in one pass once it fills,
+// so a run of k inserts costs one O(n + k log k) merge instead of k O(n) shifts.
+template<typename T>
+class SortedVector {
+private:
+    static constexpr size_t batchLimit = 64; // Pending inserts scanned linearly by lookups
+
+    mutable std::vector<T> sorted;  // Merged elements in ascending order
+    mutable std::vector<T> pending; // Recent inserts, unsorted, at most batchLimit
+
+    // Folds the pending inserts into the sorted array; logically const
+    void merge() const {
+        if (pending.empty()) {
+            return;
+        }
+        std::sort(pending.begin(), pending.end());
+        size_t middle = sorted.size();
+        sorted.insert(sorted.end(), pending.begin(), pending.end());
+        std::inplace_merge(sorted.begin(), sorted.begin() + middle, sorted.end());
+        pending.clear();
+    }
+
+public:
+    void insert(const T& x) {
+        pending.push_back(x);
+        if (pending.size() >= batchLimit) {
+            merge();
+        }
+    }
+
+    // Adds times copies of x with a single shift of the tail
+    void insert(const T& x, size_t times) {
+        merge();
+        sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), x), times, x);
+    }
+
+    bool contains(const T& x) const {
+        if (std::find(pending.begin(), pending.end(), x) != pending.end()) {
+            return true;
+        }
+        return std::binary_search(sorted.begin(), sorted.end(), x);
+    }
+
+    // Number of elements in [lo, hi]
+    size_t countRange(const T& lo, const T& hi) const {
+        if (hi < lo) {
+            return 0;
+        }
+        size_t count = std::upper_bound(sorted.begin(), sorted.end(), hi) -
+                       std::lower_bound(sorted.begin(), sorted.end(), lo);
+        for (const T& x : pending) {
+            count += !(x < lo) && !(hi < x);
+        }
+        return count;
+    }
+
+    // Removes one copy of the largest element, if any
+    void eraseMax() {
+        auto top = std::max_element(pending.begin(), pending.end());
+        if (top != pending.end() && (sorted.empty() || !(*top < sorted.back()))) {
+            *top = pending.back();
+            pending.pop_back();
+        } else if (!sorted.empty()) {
+            sorted.pop_back();
+        }
+    }
+
+    // Keeps the n smallest elements
+    void truncate(size_t n) {
+        merge();
+        if (n < sorted.size()) {
+            sorted.resize(n);
+        }
+    }
+
+    void clear() {
+        sorted.clear();
+        pending.clear();
+    }
+
+    size_t size() const { return sorted.size() + pending.size(); }
+    bool empty() const { return size() == 0; }
+
+    // Ascending iteration; merges the pending inserts first
+    auto begin() const { merge(); return sorted.cbegin(); }
+    auto end() const { merge(); return sorted.cend(); }
+};
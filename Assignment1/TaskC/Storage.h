@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Element storage backends for List. Both expose the same small deque-like surface:
+// pushBack/pushFront/popBack/popFront, resize/clear, size/empty, operator[] and iteration.
+
+// std::vector storage: O(1) at the back, O(n) at the front (the original List layout)
+template<typename T>
+class VectorStorage {
+private:
+    std::vector<T> items;
+
+public:
+    void pushBack(const T& x) { items.push_back(x); }
+    void pushFront(const T& x) { items.insert(items.begin(), x); }
+    void popBack() { items.pop_back(); }
+    void popFront() { items.erase(items.begin()); }
+    void resize(size_t n) { items.resize(n); }
+    void clear() { items.clear(); }
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    const T& operator[](size_t i) const { return items[i]; }
+    const T& front() const { return items.front(); }
+    const T& back() const { return items.back(); }
+    auto begin() const { return items.begin(); }
+    auto end() const { return items.end(); }
+};
+
+// Circular buffer over a power-of-two array: amortized O(1) pushes and O(1) pops at
+// both ends, elements stay contiguous modulo the wrap point
+template<typename T>
+class RingBuffer {
+private:
+    std::vector<T> slots; // Capacity is 0 or a power of two
+    size_t head = 0;      // Slot of the first element
+    size_t count = 0;
+
+    size_t slot(size_t i) const { return (head + i) & (slots.size() - 1); }
+
+    // Reallocates to at least minCapacity slots, unwrapping the contents to start at 0
+    void reserve(size_t minCapacity) {
+        if (minCapacity <= slots.size()) {
+            return;
+        }
+        size_t capacity = slots.empty() ? 8 : slots.size();
+        while (capacity < minCapacity) {
+            capacity *= 2;
+        }
+        std::vector<T> grown(capacity);
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move(slots[slot(i)]);
+        }
+        slots.swap(grown);
+        head = 0;
+    }
+
+public:
+    // Forward iterator over the logical order, for range-for loops
+    class const_iterator {
+    private:
+        const RingBuffer* ring;
+        size_t index;
+
+    public:
+        const_iterator(const RingBuffer* ring, size_t index) : ring(ring), index(index) {}
+        const T& operator*() const { return (*ring)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+    };
+
+    void pushBack(const T& x) {
+        reserve(count + 1);
+        slots[slot(count)] = x;
+        ++count;
+    }
+
+    void pushFront(const T& x) {
+        reserve(count + 1);
+        head = (head + slots.size() - 1) & (slots.size() - 1);
+        slots[head] = x;
+        ++count;
+    }
+
+    void popBack() {
+        --count;
+    }
+
+    void popFront() {
+        head = slot(1);
+        --count;
+    }
+
+    // Grows with value-initialized elements or drops from the back, like vector::resize
+    void resize(size_t n) {
+        reserve(n);
+        for (size_t i = count; i < n; ++i) {
+            slots[slot(i)] = T();
+        }
+        count = n;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return slots[slot(i)]; }
+    const T& front() const { return slots[head]; }
+    const T& back() const { return slots[slot(count - 1)]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
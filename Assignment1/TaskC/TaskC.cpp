@@ -1,135 +1,130 @@
 #include <iostream>
-#include <vector>
 #include <string>
+#include <type_traits>
+#include "DataStructures.h"
+#include "../../Common/FastInput.h"
+#include "../../Common/FastOutput.h"
 
 using namespace std;
 
-// Abstract base class for data structures
-class DataStructure {
-public:
-    // Pure virtual functions for common operations
-    virtual void insert(int x) = 0;
-    virtual void remove() = 0;
-    virtual bool search(int x) = 0;
-    virtual ~DataStructure() {} // Virtual destructor
-};
-
-// Abstract class for sequential data structures, inheriting from DataStructure
-class SequentialDataStructure : public virtual DataStructure {
-public:
-    // Pure virtual functions for sequential operations
-    virtual void pushBack(int x) = 0;
-    virtual void pushFront(int x) = 0;
-    virtual void popBack() = 0;
-    virtual void popFront() = 0;
-    virtual ~SequentialDataStructure() {} // Virtual destructor
-};
-
-// Abstract class for dynamic data structures, inheriting from DataStructure
-class DynamicDataStructure : public virtual DataStructure {
-public:
-    // Pure virtual functions for dynamic operations
-    virtual void resize(int new_size) = 0;
-    virtual void clear() = 0;
-    virtual ~DynamicDataStructure() {} // Virtual destructor
-};
-
-// Concrete class representing a List data structure, inheriting from both SequentialDataStructure and DynamicDataStructure
-class List : public SequentialDataStructure, public DynamicDataStructure {
-private:
-    vector<int> elements; // Vector to store elements
-
-public:
-    // Implementation of insert operation
-    void insert(int x) override {
-        elements.push_back(x);
-    }
-
-    // Implementation of remove operation
-    void remove() override {
-        if (!elements.empty()) {
-            elements.pop_back();
+// Function to run the n operations of the input against list. Under --dispatch=virtual this is
+// instantiated with DataStructure and kept out of line, so the calls go through the vtable
+// instead of being devirtualized against the final concrete list type.
+template<typename Ops>
+__attribute__((noinline)) void runOperations(FastInput& in, FastOutput& out, Ops& list, int n) {
+    // Process each operation, dispatching on the first byte of the op name
+    for (int i = 0; i < n; ++i) {
+        string_view op = in.readToken();
+
+        switch (op.empty() ? '\0' : op[0]) {
+            case 'i': // insert
+                list.insert(in.readInt());
+                break;
+            case 'r': // remove
+                list.remove();
+                break;
+            case 's': // search
+                out << (list.search(in.readInt()) ? "YES\n" : "NO\n");
+                break;
         }
     }
+}
 
-    // Implementation of search operation
-    bool search(int x) override {
-        for (int element : elements) {
-            if (element == x) {
-                return true;
-            }
-        }
-        return false;
+// Function to run the n operations of the input against list and print the results
+template<typename ListType>
+void process(FastInput& in, FastOutput& out, ListType& list, int n, bool indexed, bool indexStats) {
+    // Sorted layouts search in O(log n) without a side index
+    constexpr bool hasIndex = requires(ListType& l) { l.setIndexed(true); };
+    if constexpr (hasIndex) {
+        list.setIndexed(indexed);
     }
 
-    // Implementation of pushBack operation
-    void pushBack(int x) override {
-        elements.push_back(x);
+    if constexpr (is_base_of_v<DataStructure, ListType>) {
+        runOperations<DataStructure>(in, out, list, n);
+    } else {
+        runOperations(in, out, list, n);
     }
 
-    // Implementation of pushFront operation
-    void pushFront(int x) override {
-        elements.insert(elements.begin(), x);
-    }
+    out << list << '\n'; // Output the list elements
 
-    // Implementation of popBack operation
-    void popBack() override {
-        if (!elements.empty()) {
-            elements.pop_back();
+    if constexpr (hasIndex) {
+        if (indexStats) {
+            cerr << "Search index: " << (list.isIndexed() ? "on" : "off") << ", "
+                 << list.indexMemoryBytes() << " bytes" << endl;
         }
+    } else if (indexStats) {
+        cerr << "Search index: none (sorted layout)" << endl;
     }
+}
 
-    // Implementation of popFront operation
-    void popFront() override {
-        if (!elements.empty()) {
-            elements.erase(elements.begin());
+int main(int argc, char* argv[]) {
+    // Element storage selection: --storage=ring|vector, or a sorted layout --storage=sorted|btree
+    // (sorted layouts print the elements in ascending order and remove drops the largest)
+    // Hash index for search: --index enables it, --index-stats reports its memory on stderr
+    // Call dispatch: --dispatch=static (inlined StaticList) or --dispatch=virtual (the virtual List hierarchy)
+    string storage = "ring";
+    string dispatch = "static";
+    bool indexed = false;
+    bool indexStats = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--storage=", 0) == 0) {
+            storage = arg.substr(10);
+        } else if (arg.rfind("--dispatch=", 0) == 0) {
+            dispatch = arg.substr(11);
+        } else if (arg == "--index") {
+            indexed = true;
+        } else if (arg == "--index-stats") {
+            indexStats = true;
         }
     }
 
-    // Implementation of resize operation
-    void resize(int new_size) override {
-        elements.resize(new_size);
-    }
+    FastInput in;
+    FastOutput out;
+    int n = in.readInt();
 
-    // Implementation of clear operation
-    void clear() override {
-        elements.clear();
+    if (dispatch != "static" && dispatch != "virtual") {
+        cerr << "Error: Unknown dispatch " << dispatch << "." << endl;
+        return 1;
     }
-
-    // Overload the << operator to output the list elements
-    friend ostream& operator<<(ostream& out, const List& lst) {
-        for (int i = 0; i < lst.elements.size(); ++i) {
-            out << lst.elements[i] << " ";
+    bool isStatic = dispatch == "static";
+
+    if (storage == "ring") {
+        if (isStatic) {
+            StaticRingList list; // Create a ring-buffer-backed list without virtual calls
+            process(in, out, list, n, indexed, indexStats);
+        } else {
+            RingList list; // Create a ring-buffer-backed List object
+            process(in, out, list, n, indexed, indexStats);
         }
-        return out;
-    }
-};
-
-int main() {
-    int n;
-    cin >> n;
-
-    List list; // Create a List object
-
-    // Process each operation
-    for (int i = 0; i < n; ++i) {
-        string op;
-        cin >> op;
-
-        if (op == "insert") {
-            int x;
-            cin >> x;
-            list.insert(x);
-        } else if (op == "remove") {
-            list.remove();
-        } else if (op == "search") {
-            int x;
-            cin >> x;
-            cout << (list.search(x) ? "YES" : "NO") << endl;
+    } else if (storage == "vector") {
+        if (isStatic) {
+            StaticVectorList list; // Create a vector-backed list without virtual calls
+            process(in, out, list, n, indexed, indexStats);
+        } else {
+            List list; // Create a vector-backed List object
+            process(in, out, list, n, indexed, indexStats);
+        }
+    } else if (storage == "sorted") {
+        if (isStatic) {
+            StaticSortedVectorList list; // Create a flat sorted-vector list without virtual calls
+            process(in, out, list, n, indexed, indexStats);
+        } else {
+            SortedVectorList list; // Create a flat sorted-vector list object
+            process(in, out, list, n, indexed, indexStats);
         }
+    } else if (storage == "btree") {
+        if (isStatic) {
+            StaticBPlusTreeList list; // Create a B+-tree list without virtual calls
+            process(in, out, list, n, indexed, indexStats);
+        } else {
+            BPlusTreeList list; // Create a B+-tree list object
+            process(in, out, list, n, indexed, indexStats);
+        }
+    } else {
+        cerr << "Error: Unknown storage " << storage << "." << endl;
+        return 1;
     }
 
-    cout << list << endl; // Output the list elements
-
     return 0;
 }
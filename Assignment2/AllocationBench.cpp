@@ -0,0 +1,86 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "Game.h"
+#include "ScriptGenerator.h"
+
+using namespace std;
+
+// Harness: counts heap allocations made while Attack, Cast and Drink commands run. Setup
+// (characters, items, the command lines themselves) happens before counting starts.
+// Usage: AllocationBench [commands]. Every count should be 0 per command.
+
+static atomic<long long> allocations{0};
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Runs each line through game and returns the allocations made meanwhile
+long long countAllocations(Game& game, const vector<string>& lines) {
+    long long before = allocations;
+    for (const string& line : lines) {
+        game.execute(parseCommand(line));
+    }
+    return allocations - before;
+}
+
+void run(Game& game, const vector<string>& lines) {
+    for (const string& line : lines) {
+        game.execute(parseCommand(line));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int commands = argc > 1 ? stoi(argv[1]) : 10000;
+    FILE* sink = fopen("/dev/null", "w");
+    if (!sink) {
+        cerr << "Error: Unable to open /dev/null." << endl;
+        return 1;
+    }
+    FastOutput out(sink);
+    Game game(out);
+
+    // A fighter and an archer with full arsenals, a target too tough to die, and for each
+    // cast a fresh wizard or archer victim pair with a spell naming the victim
+    vector<string> setup = {
+        "Create character fighter hero 200",
+        "Create character archer robin 200",
+        "Create character fighter dummy 2000000000",
+        "Create item weapon hero axe 1",
+        "Create item weapon hero sword 1",
+        "Create item weapon robin bow 1",
+        "Create item potion hero elixir 1",
+    };
+    vector<string> attacks, casts, drinks;
+    for (int i = 0; i < commands; ++i) {
+        attacks.push_back(i % 2 ? "Attack hero dummy sword" : "Attack robin dummy bow");
+        drinks.push_back("Drink hero dummy nothing"); // The potion is looked up, not found
+        string caster = entityName("w", i), victim = entityName("v", i), spell = entityName("s", i);
+        setup.push_back("Create character " + string(i % 2 ? "wizard " : "archer ") + caster + " 100");
+        setup.push_back("Create character fighter " + victim + " 100");
+        setup.push_back("Create item spell " + caster + " " + spell + " 1 [" + victim + "]");
+        casts.push_back("Cast " + caster + " " + victim + " " + spell);
+    }
+    run(game, setup);
+
+    long long attackAllocations = countAllocations(game, attacks);
+    long long castAllocations = countAllocations(game, casts);
+    long long drinkAllocations = countAllocations(game, drinks);
+    cout << "commands per kind: " << commands << endl;
+    cout << "Attack: " << attackAllocations << " allocations (" << (double)attackAllocations / commands << " per command)" << endl;
+    cout << "Cast:   " << castAllocations << " allocations (" << (double)castAllocations / commands << " per command)" << endl;
+    cout << "Drink:  " << drinkAllocations << " allocations (" << (double)drinkAllocations / commands << " per command)" << endl;
+    return 0;
+}
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Game.h"
+
+// Binary command log: a script stored as typed event records with every text field interned,
+// plus snapshots of the Game state taken every few events, so a replay skips tokenizing and
+// can start at the nearest snapshot instead of at event 0.
+//
+// Layout; integers are LEB128 varints, the signed ones zigzag-encoded:
+//   "A2CL" version
+//   declared event count (signed; checked on replay like the script's first line)
+//   string count, then each string as length + bytes
+//   record count, record bytes, then the records: a CommandType byte and that type's fields
+//   snapshot count, then per snapshot: event index, record offset, body length, body
+//
+// A snapshot body lists the living characters in name order: kind byte, name, hp and each
+// container (count, then name and value per item; spells add the names of their owners).
+
+// Fields each record carries after its type byte, in this order
+enum LogField : uint8_t { LogKind = 1, LogActor = 2, LogTarget = 4, LogItem = 8, LogValue = 16, LogRest = 32 };
+
+constexpr uint8_t logFields(CommandType type) {
+    switch (type) {
+        case CommandType::CreateCharacter: return LogKind | LogActor | LogValue;
+        case CommandType::CreateItem: return LogKind | LogActor | LogItem | LogValue | LogRest;
+        case CommandType::Attack:
+        case CommandType::Cast:
+        case CommandType::Drink: return LogActor | LogTarget | LogItem;
+        case CommandType::Dialogue: return LogActor | LogValue | LogRest;
+        case CommandType::ShowItems: return LogKind | LogActor;
+        default: return 0;
+    }
+}
+
+class LogEncoder {
+public:
+    std::string bytes;
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(char(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(char(value));
+    }
+
+    void putSigned(long long value) {
+        putVarint((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+    }
+
+    void putBytes(std::string_view data) {
+        putVarint(data.size());
+        bytes.append(data);
+    }
+};
+
+// Reads what LogEncoder wrote; running off the end yields zeros and empty views
+class LogDecoder {
+private:
+    const char* pos;
+    const char* end;
+    bool overran = false; // A read wanted more bytes than were left
+
+public:
+    explicit LogDecoder(std::string_view data) : pos(data.data()), end(data.data() + data.size()) {}
+
+    size_t remaining() const { return end - pos; }
+    bool truncated() const { return overran; }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == end) {
+                overran = true;
+                break;
+            }
+            unsigned char b = *pos++;
+            value |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    long long signedVarint() {
+        uint64_t value = varint();
+        return (long long)(value >> 1) ^ -(long long)(value & 1);
+    }
+
+    unsigned char byte() {
+        if (pos == end) {
+            overran = true;
+            return 0;
+        }
+        return *pos++;
+    }
+
+    std::string_view bytes(uint64_t length) {
+        if (length > remaining()) {
+            overran = true;
+            length = remaining();
+        }
+        std::string_view data(pos, length);
+        pos += length;
+        return data;
+    }
+
+    std::string_view bytes() {
+        return bytes(varint());
+    }
+};
+
+// Builds a log from parsed commands; snapshot() records the game state after the events so far
+class CommandLogWriter {
+private:
+    SymbolTable strings;
+    LogEncoder records;
+    LogEncoder snapshots;
+    long long declaredCount;
+    size_t events = 0;
+    size_t snapshotCount = 0;
+
+    template<typename T>
+    void putContainer(LogEncoder& body, Game& game, const Container<T>& container) {
+        body.putVarint(container.size());
+        for (const auto& item : container.getContent()) {
+            body.putVarint(strings.intern(item->name));
+            body.putSigned(item->healthAffectValue);
+            if constexpr (std::is_same_v<T, Spell>) {
+                // Dead owners can never be targeted again, so only the living ones are kept
+                std::vector<int> alive;
+                for (const auto& owner : item->owners) {
+                    if (game.findCharacter(owner->name) == owner) {
+                        alive.push_back(strings.intern(owner->name));
+                    }
+                }
+                body.putVarint(alive.size());
+                for (int id : alive) {
+                    body.putVarint(id);
+                }
+            }
+        }
+    }
+
+public:
+    explicit CommandLogWriter(long long declaredCount) : declaredCount(declaredCount) {}
+
+    void append(const Command& command) {
+        uint8_t fields = logFields(command.type);
+        records.bytes.push_back(char(command.type));
+        if (fields & LogKind) records.putVarint(strings.intern(command.kind));
+        if (fields & LogActor) records.putVarint(strings.intern(command.actor));
+        if (fields & LogTarget) records.putVarint(strings.intern(command.target));
+        if (fields & LogItem) records.putVarint(strings.intern(command.item));
+        if (fields & LogValue) records.putSigned(command.value);
+        if (fields & LogRest) records.putVarint(strings.intern(command.rest));
+        ++events;
+    }
+
+    void snapshot(Game& game) {
+        std::vector<Character*> living;
+        game.characters.forEachSorted(game.symbols, [&](const shared_ptr<Character>& character) {
+            living.push_back(character.get());
+        });
+        LogEncoder body;
+        body.putVarint(living.size());
+        for (Character* character : living) {
+            body.bytes.push_back(char(character->kind));
+            body.putVarint(strings.intern(character->name));
+            body.putSigned(character->hp);
+            switch (character->kind) {
+                case CharacterKind::Fighter: {
+                    auto& fighter = static_cast<Fighter&>(*character);
+                    putContainer(body, game, fighter.arsenal);
+                    putContainer(body, game, fighter.bag);
+                    break;
+                }
+                case CharacterKind::Wizard: {
+                    auto& wizard = static_cast<Wizard&>(*character);
+                    putContainer(body, game, wizard.book);
+                    putContainer(body, game, wizard.bag);
+                    break;
+                }
+                case CharacterKind::Archer: {
+                    auto& archer = static_cast<Archer&>(*character);
+                    putContainer(body, game, archer.arsenal);
+                    putContainer(body, game, archer.bag);
+                    putContainer(body, game, archer.book);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        snapshots.putVarint(events);
+        snapshots.putVarint(records.bytes.size());
+        snapshots.putBytes(body.bytes);
+        ++snapshotCount;
+    }
+
+    size_t snapshotsTaken() const { return snapshotCount; }
+
+    // The finished log
+    std::string finish() const {
+        LogEncoder log;
+        log.bytes = "A2CL";
+        log.putVarint(1);
+        log.putSigned(declaredCount);
+        log.putVarint(strings.size());
+        for (size_t id = 0; id < strings.size(); ++id) {
+            log.putBytes(strings.name(id));
+        }
+        log.putVarint(events);
+        log.putBytes(records.bytes);
+        log.putVarint(snapshotCount);
+        log.bytes += snapshots.bytes;
+        return log.bytes;
+    }
+};
+
+// Replays a log held in memory (e.g. a mapped file); strings stay views into it
+class CommandLogReader {
+private:
+    struct Snapshot {
+        size_t event;
+        size_t recordOffset;
+        std::string_view body;
+    };
+
+    bool ok = false;
+    long long declaredCount = 0;
+    size_t events = 0;
+    std::vector<std::string_view> strings;
+    std::string_view records;
+    std::vector<Snapshot> snapshots; // In event order
+
+    std::string_view string(LogDecoder& decoder) const {
+        uint64_t id = decoder.varint();
+        return id < strings.size() ? strings[id] : std::string_view();
+    }
+
+    template<typename T>
+    void readContainer(LogDecoder& body, Game& game, Container<T>& container,
+                       std::vector<std::pair<Spell*, std::string_view>>& owners) const {
+        for (uint64_t count = body.varint(); count > 0; --count) {
+            std::string_view name = string(body);
+            auto item = game.spawnItem<T>(name, (int)body.signedVarint());
+            if constexpr (std::is_same_v<T, Spell>) {
+                for (uint64_t k = body.varint(); k > 0; --k) {
+                    owners.emplace_back(item.get(), string(body));
+                }
+            }
+            container.addItem(item);
+        }
+    }
+
+    // Rebuilds the living characters of snapshot into an empty game, printing nothing
+    void restore(Game& game, const Snapshot& snapshot) const {
+        LogDecoder body(snapshot.body);
+        std::vector<std::pair<Spell*, std::string_view>> owners; // Resolved once everyone exists
+        for (uint64_t count = body.varint(); count > 0; --count) {
+            auto kind = CharacterKind(body.byte());
+            std::string_view name = string(body);
+            int hp = (int)body.signedVarint();
+            shared_ptr<Character> character;
+            switch (kind) {
+                case CharacterKind::Fighter: {
+                    auto fighter = game.spawn<Fighter>();
+                    readContainer(body, game, fighter->arsenal, owners);
+                    readContainer(body, game, fighter->bag, owners);
+                    character = std::move(fighter);
+                    break;
+                }
+                case CharacterKind::Wizard: {
+                    auto wizard = game.spawn<Wizard>();
+                    readContainer(body, game, wizard->book, owners);
+                    readContainer(body, game, wizard->bag, owners);
+                    character = std::move(wizard);
+                    break;
+                }
+                case CharacterKind::Archer: {
+                    auto archer = game.spawn<Archer>();
+                    readContainer(body, game, archer->arsenal, owners);
+                    readContainer(body, game, archer->bag, owners);
+                    readContainer(body, game, archer->book, owners);
+                    character = std::move(archer);
+                    break;
+                }
+                default:
+                    return;
+            }
+            character->name = name;
+            character->hp = hp;
+            game.characters.set(game.symbols.intern(name), std::move(character));
+        }
+        for (const auto& [spell, ownerName] : owners) {
+            if (const auto& owner = game.findCharacter(ownerName)) {
+                spell->addOwner(owner);
+            }
+        }
+    }
+
+public:
+    explicit CommandLogReader(std::string_view data) {
+        if (data.substr(0, 4) != "A2CL") {
+            return;
+        }
+        LogDecoder header(data.substr(4));
+        if (header.varint() != 1) {
+            return;
+        }
+        declaredCount = header.signedVarint();
+        // Counts come from the file, so each is checked against the bytes it needs before
+        // anything is allocated for it: a string takes at least its length byte, an event
+        // its type byte and a snapshot its three varints
+        uint64_t stringCount = header.varint();
+        if (stringCount > header.remaining()) {
+            return;
+        }
+        strings.resize(stringCount);
+        for (auto& s : strings) {
+            s = header.bytes();
+        }
+        events = header.varint();
+        records = header.bytes();
+        if (events > records.size()) {
+            return;
+        }
+        uint64_t snapshotCount = header.varint();
+        if (snapshotCount > header.remaining() / 3) {
+            return;
+        }
+        snapshots.reserve(snapshotCount);
+        for (uint64_t count = snapshotCount; count > 0; --count) {
+            size_t event = header.varint();
+            size_t offset = header.varint();
+            snapshots.push_back({event, offset, header.bytes()});
+        }
+        ok = !header.truncated();
+    }
+
+    bool valid() const { return ok; }
+    size_t eventCount() const { return events; }
+
+    // Replays into an empty game from the latest snapshot at or before event from; returns
+    // the event it started at. Output covers the events from there on.
+    size_t replay(Game& game, size_t from = 0) const {
+        auto after = std::upper_bound(snapshots.begin(), snapshots.end(), from,
+                                      [](size_t event, const Snapshot& s) { return event < s.event; });
+        size_t start = 0;
+        LogDecoder decoder(records);
+        if (after == snapshots.begin()) {
+            game.checkEventCount((int)declaredCount);
+        } else {
+            const Snapshot& snapshot = *(after - 1);
+            restore(game, snapshot);
+            start = snapshot.event;
+            decoder = LogDecoder(records.substr(std::min(snapshot.recordOffset, records.size())));
+        }
+        for (size_t i = start; i < events; ++i) {
+            Command command;
+            command.type = CommandType(decoder.byte());
+            uint8_t fields = logFields(command.type);
+            if (fields & LogKind) command.kind = string(decoder);
+            if (fields & LogActor) command.actor = string(decoder);
+            if (fields & LogTarget) command.target = string(decoder);
+            if (fields & LogItem) command.item = string(decoder);
+            if (fields & LogValue) command.value = (int)decoder.signedVarint();
+            if (fields & LogRest) command.rest = string(decoder);
+            game.execute(command);
+        }
+        return start;
+    }
+};
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include "CommandLog.h"
+
+using namespace std;
+
+// Converts Assignment2 scripts to binary command logs and replays them.
+// Usage: CommandLogTool convert <script.txt> <log.a2cl> [--snapshot-every=N]
+//        CommandLogTool replay <log.a2cl> <output.txt> [--from=EVENT]
+// convert plays the script once (output discarded) to take a snapshot every N events
+// (default 256). replay --from starts at the latest snapshot at or before EVENT, and the
+// output then covers the events from that snapshot on.
+
+int convert(const string& scriptPath, const string& logPath, size_t snapshotEvery) {
+    int scriptFile = open(scriptPath.c_str(), O_RDONLY);
+    FILE* sink = fopen("/dev/null", "w");
+    if (scriptFile < 0 || !sink) {
+        cerr << "Error: Unable to open input file." << endl;
+        return 1;
+    }
+    string log;
+    size_t events = 0, snapshots = 0, textBytes = 0;
+    {
+        FastInput in(scriptFile);
+        textBytes = in.remaining().size();
+        FastOutput out(sink);
+        Game game(out);
+        // Same reading as Game::processCommands; lines past the end of the script are no-ops
+        int n = in.readInt();
+        in.readLine();
+        CommandLogWriter writer(n);
+        for (int i = 0; i < n && !in.remaining().empty(); ++i) {
+            Command command = parseCommand(in.readLine());
+            writer.append(command);
+            game.execute(command);
+            if (++events % snapshotEvery == 0) {
+                writer.snapshot(game);
+            }
+        }
+        log = writer.finish();
+        snapshots = writer.snapshotsTaken();
+    }
+    close(scriptFile);
+    fclose(sink);
+
+    FILE* logFile = fopen(logPath.c_str(), "wb");
+    if (!logFile || fwrite(log.data(), 1, log.size(), logFile) != log.size()) {
+        cerr << "Error: Unable to write output file." << endl;
+        if (logFile) fclose(logFile);
+        return 1;
+    }
+    fclose(logFile);
+    cout << events << " events, " << snapshots << " snapshots: " << textBytes << " text bytes -> "
+         << log.size() << " log bytes" << endl;
+    return 0;
+}
+
+int replay(const string& logPath, const string& outputPath, size_t from) {
+    int logFile = open(logPath.c_str(), O_RDONLY);
+    if (logFile < 0) {
+        cerr << "Error: Unable to open input file." << endl;
+        return 1;
+    }
+    FILE* outputFile = fopen(outputPath.c_str(), "w");
+    if (!outputFile) {
+        cerr << "Error: Unable to open output file." << endl;
+        close(logFile);
+        return 1;
+    }
+    int status = 0;
+    {
+        FastInput in(logFile); // The log is mapped; replayed strings are views into it
+        CommandLogReader reader(in.remaining());
+        if (reader.valid()) {
+            FastOutput out(outputFile);
+            Game game(out);
+            size_t start = reader.replay(game, from);
+            if (start > 0) {
+                cerr << "Replayed from the snapshot at event " << start << "." << endl;
+            }
+        } else {
+            cerr << "Error: " << logPath << " is not a command log." << endl;
+            status = 1;
+        }
+    }
+    close(logFile);
+    fclose(outputFile);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    size_t snapshotEvery = 256, from = 0;
+    for (int i = 4; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--snapshot-every=", 0) == 0) {
+            snapshotEvery = max(1ul, stoul(arg.substr(17)));
+        } else if (arg.rfind("--from=", 0) == 0) {
+            from = stoul(arg.substr(7));
+        }
+    }
+    if (argc >= 4 && mode == "convert") {
+        return convert(argv[2], argv[3], snapshotEvery);
+    }
+    if (argc >= 4 && mode == "replay") {
+        return replay(argv[2], argv[3], from);
+    }
+    cerr << "Usage: " << argv[0] << " convert <script.txt> <log.a2cl> [--snapshot-every=N]" << endl
+         << "       " << argv[0] << " replay <log.a2cl> <output.txt> [--from=EVENT]" << endl;
+    return 1;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <charconv>
+#include <string_view>
+
+// Script line kinds, see Assignment2Description.txt for the formats
+enum class CommandType {
+    CreateCharacter, // Create character <kind> <actor> <value: initHP>
+    CreateItem,      // Create item <kind> <actor: owner> <item> <value> <rest: target list, optionally in []>
+    Attack,          // Attack <actor> <target> <item: weapon>
+    Cast,            // Cast <actor> <target> <item: spell>
+    Drink,           // Drink <actor: supplier> <target: drinker> <item: potion>
+    Dialogue,        // Dialogue <actor: speaker> <value: word count> <rest: words>
+    ShowCharacters,  // Show characters
+    ShowItems,       // Show <kind: item type> <actor>
+    Unknown
+};
+
+// One parsed script line. Text fields are views into the line, which must outlive them.
+struct Command {
+    CommandType type = CommandType::Unknown;
+    std::string_view kind;
+    std::string_view actor;
+    std::string_view target;
+    std::string_view item;
+    int value = 0;
+    std::string_view rest;
+};
+
+// Takes the text up to the next space off the front of line (all of it if there is none)
+inline std::string_view nextField(std::string_view& line) {
+    size_t space = line.find(' ');
+    std::string_view field = line.substr(0, space);
+    line.remove_prefix(space == std::string_view::npos ? line.size() : space + 1);
+    return field;
+}
+
+// Leading decimal integer of field, like stoi
+inline int parseInt(std::string_view field) {
+    if (!field.empty() && field.front() == '+') {
+        field.remove_prefix(1);
+    }
+    int value = 0;
+    std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+// Splits a script line into a Command in one left-to-right pass, without copying text.
+// The last field of Attack, Cast, Drink and Show items is the rest of the line.
+inline Command parseCommand(std::string_view line) {
+    Command command;
+    std::string_view word = nextField(line);
+    if (word == "Create") {
+        std::string_view what = nextField(line);
+        command.kind = nextField(line);
+        command.actor = nextField(line);
+        if (what == "character") {
+            command.type = CommandType::CreateCharacter;
+            command.value = parseInt(nextField(line));
+        } else {
+            command.type = CommandType::CreateItem;
+            command.item = nextField(line);
+            std::string_view list = line;
+            command.value = parseInt(nextField(line));
+            // The list follows '[' if there is one; otherwise, as in the original substr(find("[") + 1),
+            // it is the whole text from the value field on
+            size_t open = list.find('[');
+            if (open != std::string_view::npos) {
+                list.remove_prefix(open + 1);
+            }
+            command.rest = list.substr(0, list.find(']'));
+        }
+    } else if (word == "Attack" || word == "Cast" || word == "Drink") {
+        command.type = word == "Attack" ? CommandType::Attack : word == "Cast" ? CommandType::Cast : CommandType::Drink;
+        command.actor = nextField(line);
+        command.target = nextField(line);
+        command.item = line;
+    } else if (word == "Dialogue") {
+        command.type = CommandType::Dialogue;
+        command.actor = nextField(line);
+        command.value = parseInt(nextField(line));
+        command.rest = line;
+    } else if (word == "Show") {
+        std::string_view what = nextField(line);
+        if (what == "characters") {
+            command.type = CommandType::ShowCharacters;
+        } else {
+            command.type = CommandType::ShowItems;
+            command.kind = what;
+            command.actor = line;
+        }
+    }
+    return command;
+}
+
+// Calls visit for each entry of a ", "-separated list; an empty list yields one empty entry
+template<typename Visitor>
+void forEachListed(std::string_view list, Visitor visit) {
+    for (;;) {
+        size_t comma = list.find(", ");
+        visit(list.substr(0, comma));
+        if (comma == std::string_view::npos) {
+            return;
+        }
+        list.remove_prefix(comma + 2);
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Fixed-size block allocator: carves blocks out of large slabs and recycles freed blocks
+// through an intrusive free list. Slabs are only released, all at once, with the pool.
+class SlabPool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t blockSize;
+    size_t slabBlocks;
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+    FreeBlock* freeList = nullptr;
+    std::byte* cursor = nullptr;  // Next never-used block in the newest slab
+    std::byte* slabEnd = nullptr;
+
+public:
+    explicit SlabPool(size_t size, size_t slabBlocks = 256) : slabBlocks(slabBlocks) {
+        const size_t align = alignof(std::max_align_t);
+        blockSize = (std::max(size, sizeof(FreeBlock)) + align - 1) / align * align;
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* allocate() {
+        if (freeList) {
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            return block;
+        }
+        if (cursor == slabEnd) {
+            slabs.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize * slabBlocks));
+            cursor = slabs.back().get();
+            slabEnd = cursor + blockSize * slabBlocks;
+        }
+        void* block = cursor;
+        cursor += blockSize;
+        return block;
+    }
+
+    void deallocate(void* pointer) {
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeList;
+        freeList = block;
+    }
+
+    // Bytes reserved from the heap so far
+    size_t reservedBytes() const { return slabs.size() * slabBlocks * blockSize; }
+};
+
+// One SlabPool per allocated type, created on first use. The slabs are freed without running
+// any destructor, so owners must destroy their objects (and break shared_ptr cycles) first.
+class EntityArena {
+private:
+    std::vector<std::unique_ptr<SlabPool>> pools; // Indexed by type slot
+
+    static size_t nextSlot() {
+        static std::atomic<size_t> next{0};
+        return next++;
+    }
+
+    // Dense process-wide index for type U
+    template<typename U>
+    static size_t slotOf() {
+        static const size_t slot = nextSlot();
+        return slot;
+    }
+
+public:
+    template<typename U>
+    SlabPool& poolFor() {
+        static_assert(alignof(U) <= alignof(std::max_align_t), "over-aligned types are not pooled");
+        size_t slot = slotOf<U>();
+        if (slot >= pools.size()) {
+            pools.resize(slot + 1);
+        }
+        if (!pools[slot]) {
+            pools[slot] = std::make_unique<SlabPool>(sizeof(U));
+        }
+        return *pools[slot];
+    }
+
+    size_t reservedBytes() const {
+        size_t total = 0;
+        for (const auto& pool : pools) {
+            if (pool) total += pool->reservedBytes();
+        }
+        return total;
+    }
+};
+
+// Standard allocator over an EntityArena, for allocate_shared: the object and its control
+// block share one pooled block. Array requests bypass the pools.
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    EntityArena* arena;
+
+    explicit PoolAllocator(EntityArena& arena) noexcept : arena(&arena) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(arena->poolFor<T>().allocate());
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept {
+        if (n == 1) {
+            arena->poolFor<T>().deallocate(pointer);
+        } else {
+            std::allocator<T>().deallocate(pointer, n);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return arena == other.arena; }
+};
@@ -0,0 +1,619 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "../Common/FastInput.h"
+#include "../Common/FastOutput.h"
+#include "CommandParser.h"
+#include "EntityPool.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+// Concrete item type, stored in every item so dispatch is a switch instead of RTTI casts
+enum class ItemKind { Weapon, Potion, Spell };
+
+class PhysicalItem {
+public:
+    const ItemKind kind;
+    string name;
+    int nameId = -1; // Interned name, see SymbolTable
+    int healthAffectValue{};
+    explicit PhysicalItem(ItemKind kind) : kind(kind) {}
+    virtual ~PhysicalItem() = default;
+};
+
+template <typename T>
+concept DerivedFromPhysicalItem = is_base_of_v<PhysicalItem, T>;
+
+// Items are kept in insertion order; slotIds mirrors content with each item's interned
+// name, so a lookup by name scans a few ints instead of comparing strings. Names are unique.
+template<DerivedFromPhysicalItem T>
+class Container {
+protected:
+    vector<shared_ptr<T>> content;
+    vector<int> slotIds; // Name id of content[i]
+public:
+    [[nodiscard]] const vector<shared_ptr<T>>& getContent() const { return content; }
+    [[nodiscard]] int size() const { return content.size(); }
+    void addItem(const shared_ptr<T>& item) {
+        content.push_back(item);
+        slotIds.push_back(item->nameId);
+    }
+    // Slot of the item named nameId, or -1
+    [[nodiscard]] int find(int nameId) const {
+        auto slot = std::find(slotIds.begin(), slotIds.end(), nameId);
+        return slot == slotIds.end() ? -1 : int(slot - slotIds.begin());
+    }
+    [[nodiscard]] const shared_ptr<T>& at(int slot) const { return content[slot]; }
+    void erase(int slot) {
+        content.erase(content.begin() + slot);
+        slotIds.erase(slotIds.begin() + slot);
+    }
+    virtual ~Container() = default;
+};
+
+// Concrete character type, stored in every character for the same reason
+enum class CharacterKind { Narrator, Fighter, Wizard, Archer };
+
+// Lower-case type name as shown by "Show characters"
+inline const char* kindName(CharacterKind kind) {
+    switch (kind) {
+        case CharacterKind::Narrator: return "narrator";
+        case CharacterKind::Fighter: return "fighter";
+        case CharacterKind::Wizard: return "wizard";
+        case CharacterKind::Archer: return "archer";
+    }
+    return "";
+}
+
+class Character {
+public:
+    const CharacterKind kind;
+    string name;
+    int hp{};
+    explicit Character(CharacterKind kind) : kind(kind) {}
+    virtual bool attack(FastOutput& out, Character& target, string_view weaponName) {
+        out << name << " attacks " << target.name << " with " << weaponName << "!" << '\n';
+    }
+    virtual ~Character() = default;
+    virtual void show(FastOutput& out, string_view itemType) {
+        out << "Showing items for character " << name << " not implemented." << '\n';
+    }
+};
+
+
+class Weapon : public PhysicalItem {
+public:
+    Weapon() : PhysicalItem(ItemKind::Weapon) {}
+};
+
+class Potion : public PhysicalItem {
+public:
+    Potion() : PhysicalItem(ItemKind::Potion) {}
+};
+
+class Spell : public PhysicalItem {
+public:
+    Spell() : PhysicalItem(ItemKind::Spell) {}
+    vector<shared_ptr<Character>> owners;
+    void addOwner(const shared_ptr<Character>& owner) {
+        owners.push_back(owner);
+    }
+};
+
+class Arsenal : public Container<Weapon> {
+public:
+    void showItems(FastOutput& out, string_view itemType){
+        if (itemType == "weapons" || itemType == "weapon") {
+            for (const auto& item : content) {
+                out << item->name <<":"<<item->healthAffectValue;
+            }
+            out << '\n';
+        } else {
+            out << "Error: No items of type " << itemType << " in Arsenal." << '\n';
+        }
+    }
+};
+
+class MedicalBag : public Container<Potion> {
+public:
+    void showItems(FastOutput& out, string_view itemType){
+        if (itemType == "potions" || itemType == "potion") {
+            for (const auto& item : content) {
+                out << item->name <<":"<<item->healthAffectValue << " ";
+            }
+            out << '\n';
+        } else {
+            out << "Error: No items of type " << itemType << " in MedicalBag." << '\n';
+        }
+    }
+};
+
+class SpellBook : public Container<Spell> {
+public:
+    void showItems(FastOutput& out, string_view itemType){
+        if (itemType == "spells" || itemType == "spell") {
+            for (const auto& item : content) {
+                out << item->name <<":"<<item->healthAffectValue;
+            }
+            out << '\n';
+        } else {
+            out << "Error: No items of type " << itemType << " in SpellBook." << '\n';
+        }
+    }
+};
+
+// One per Game rather than a process-wide singleton, so concurrent sessions share nothing
+class Narrator: public Character {
+public:
+    Narrator() : Character(CharacterKind::Narrator) { name = "Narrator"; }
+    Narrator(const Narrator&) = delete;
+    Narrator& operator=(const Narrator&) = delete;
+};
+
+class Fighter : public Character {
+public:
+    Arsenal arsenal;
+    MedicalBag bag;
+    Fighter() : Character(CharacterKind::Fighter) {}
+    void addItem(FastOutput& out, const shared_ptr<PhysicalItem>& Item) {
+        switch (Item->kind) {
+            case ItemKind::Weapon:
+                if (arsenal.size() < 3) {
+                    arsenal.addItem(static_pointer_cast<Weapon>(Item));
+                    out << name << " just obtained a new weapon called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            case ItemKind::Potion:
+                if (bag.size() < 5) {
+                    bag.addItem(static_pointer_cast<Potion>(Item));
+                    out << name << " just obtained a new potion called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            default:
+                out << "Error caught" << '\n';
+        }
+    }
+    bool attack(FastOutput& out, Character& target, string_view weaponName) override {
+        const auto& attackerWeapon = arsenal.getContent().front();
+        target.hp -= attackerWeapon->healthAffectValue;
+        out << name << " attacks " << target.name << " with their " << weaponName << "!" << '\n';
+        if (target.hp <= 0) {
+            out << target.name << " has died..." << '\n';
+            return true;
+        }
+        return false;
+    }
+    void show(FastOutput& out, string_view itemType) override {
+        if (itemType == "weapons" || itemType == "weapon") {
+            arsenal.showItems(out, itemType);
+        } else if (itemType == "potions" || itemType == "potion") {
+            bag.showItems(out, itemType);
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+};
+
+class Wizard : public Character {
+public:
+    SpellBook book;
+    MedicalBag bag;
+    Wizard() : Character(CharacterKind::Wizard) {}
+    void addItem(FastOutput& out, const shared_ptr<PhysicalItem>& Item) {
+        switch (Item->kind) {
+            case ItemKind::Spell:
+                if (book.size() < 10) {
+                    book.addItem(static_pointer_cast<Spell>(Item));
+                    out << name << " just obtained a new spell called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            case ItemKind::Potion:
+                if (bag.size() < 10) {
+                    bag.addItem(static_pointer_cast<Potion>(Item));
+                    out << name << " just obtained a new potion called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            default:
+                out << "Error caught" << '\n';
+        }
+    }
+    void show(FastOutput& out, string_view itemType) override {
+        if (itemType == "spell" || itemType == "spells") {
+            book.showItems(out, itemType);
+        } else if (itemType == "potions" || itemType == "potion") {
+            bag.showItems(out, itemType);
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+};
+
+class Archer : public Character {
+public:
+    Arsenal arsenal;
+    MedicalBag bag;
+    SpellBook book;
+    Archer() : Character(CharacterKind::Archer) {}
+    void addItem(FastOutput& out, const shared_ptr<PhysicalItem>& Item) {
+        switch (Item->kind) {
+            case ItemKind::Spell:
+                if (book.size() < 2) {
+                    book.addItem(static_pointer_cast<Spell>(Item));
+                    out << name << " just obtained a new spell called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            case ItemKind::Potion:
+                if (bag.size() < 3) {
+                    bag.addItem(static_pointer_cast<Potion>(Item));
+                    out << name << " just obtained a new potion called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+            case ItemKind::Weapon:
+                if (arsenal.size() < 2) {
+                    arsenal.addItem(static_pointer_cast<Weapon>(Item));
+                    out << name << " just obtained a new weapon called " << Item->name << "." << '\n';
+                } else {
+                    out << "Error caught" << '\n';
+                }
+                break;
+        }
+    }
+    bool attack(FastOutput& out, Character& target, string_view weaponName) override {
+        const auto& attackerWeapon = arsenal.getContent().front();
+        target.hp -= attackerWeapon->healthAffectValue;
+        out << name << " attacks " << target.name << " with their " << weaponName << "!" << '\n';
+        if (target.hp <= 0) {
+            out << target.name << " has died..." << '\n';
+            return true;
+        }
+        return false;
+    }
+    void show(FastOutput& out, string_view itemType) override {
+        if (itemType == "weapons" || itemType == "weapon") {
+            arsenal.showItems(out, itemType);
+        } else if (itemType == "potions" || itemType == "potion") {
+            bag.showItems(out, itemType);
+        }else if (itemType == "spells" || itemType == "spell") {
+            book.showItems(out, itemType);
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+};
+
+class Game {
+public:
+    FastOutput& out; // Sink for every event line of the story
+    EntityArena arena; // Backs every character and item; declared first so it is torn down last, in bulk
+    SymbolTable symbols; // Character and item names, interned
+    SymbolMap<Character> characters; // Living characters by name id
+    Narrator narrator; // This session's narrator
+    vector<weak_ptr<Spell>> spells; // Every spell spawned, to break spell-owner cycles at teardown
+    size_t pruneSpellsAt = 64; // Expired entries are dropped when spells reaches this size
+    explicit Game(FastOutput& out) : out(out) {}
+
+    // A spell owned by a character it lists as an owner (directly or through other spells) is
+    // a shared_ptr cycle; clearing every owner list frees those while the arena is still here
+    ~Game() {
+        for (const auto& weakSpell : spells) {
+            if (auto spell = weakSpell.lock()) {
+                spell->owners.clear();
+            }
+        }
+    }
+
+    // Pooled replacement for make_shared: object and control block come from the game's arena
+    template<typename T>
+    shared_ptr<T> spawn() {
+        return allocate_shared<T>(PoolAllocator<T>(arena));
+    }
+
+    // Living character called name, or an empty pointer
+    const shared_ptr<Character>& findCharacter(string_view name) const {
+        return characters.get(symbols.find(name));
+    }
+
+    void createCharacter(string_view type, string_view name, int initHP) {
+        shared_ptr<Character> character;
+        if (type == "fighter") {
+            character = spawn<Fighter>();
+            out << "A new fighter came to town, " << name << "." << '\n';
+        }
+        else if (type == "wizard") {
+            character = spawn<Wizard>();
+            out << "A new wizard came to town, " << name << "." << '\n';
+        }
+        else if (type == "archer") {
+            character = spawn<Archer>();
+            out << "A new archer came to town, " << name << "." << '\n';
+        }
+        character->name = name;
+        character->hp = initHP;
+        characters.set(symbols.intern(name), std::move(character));
+    }
+
+    // Hands item to the owner's addItem, which rejects the kinds that character can't carry
+    void giveItem(Character& owner, const shared_ptr<PhysicalItem>& item) {
+        switch (owner.kind) {
+            case CharacterKind::Fighter:
+                static_cast<Fighter&>(owner).addItem(out, item);
+                break;
+            case CharacterKind::Wizard:
+                static_cast<Wizard&>(owner).addItem(out, item);
+                break;
+            case CharacterKind::Archer:
+                static_cast<Archer&>(owner).addItem(out, item);
+                break;
+            default:
+                out << "Error caught" << '\n';
+        }
+    }
+
+    // Pooled item of type T with its name interned
+    template<typename T>
+    shared_ptr<T> spawnItem(string_view itemName, int value) {
+        auto item = spawn<T>();
+        item->name = itemName;
+        item->nameId = symbols.intern(itemName);
+        item->healthAffectValue = value;
+        if constexpr (is_same_v<T, Spell>) {
+            if (spells.size() >= pruneSpellsAt) {
+                erase_if(spells, [](const weak_ptr<Spell>& spell) { return spell.expired(); });
+                pruneSpellsAt = max(pruneSpellsAt, 2 * spells.size());
+            }
+            spells.push_back(item);
+        }
+        return item;
+    }
+
+    void createItem(string_view itemType, string_view ownerName, string_view itemName, int value, string_view targetList) {
+        const auto& owner = findCharacter(ownerName);
+        if (owner) {
+            if (itemType == "weapon") {
+                giveItem(*owner, spawnItem<Weapon>(itemName, value));
+            } else if (itemType == "potion") {
+                giveItem(*owner, spawnItem<Potion>(itemName, value));
+            } else if (itemType == "spell" || itemType == "spells") {
+                auto spell = spawnItem<Spell>(itemName, value);
+                forEachListed(targetList, [&](string_view characterName) {
+                    if (const auto& target = findCharacter(characterName)) {
+                        spell->addOwner(target);
+                    }
+                });
+                giveItem(*owner, spell);
+            } else {
+                out << "Error caught" << '\n';
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    // Attack with a weapon from attacker's arsenal (Fighter or Archer). Everything is reached by
+    // reference; a killed target leaves the map last, since it may be the attacker itself.
+    template<typename Attacker>
+    void attackWith(Attacker& attacker, int targetId, string_view weaponName) {
+        Character& targetCharacter = *characters.get(targetId);
+        if (attacker.arsenal.find(symbols.find(weaponName)) >= 0) {
+            attacker.attack(out, targetCharacter, weaponName);
+            if (targetCharacter.hp <= 0) {
+                characters.erase(targetId);
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    void performAttack(string_view attackerName, string_view targetName, string_view weaponName) {
+        int targetId = symbols.find(targetName);
+        const auto& attackerCharacter = findCharacter(attackerName);
+        if (attackerCharacter && characters.get(targetId)) {
+            switch (attackerCharacter->kind) {
+                case CharacterKind::Fighter:
+                    attackWith(static_cast<Fighter&>(*attackerCharacter), targetId, weaponName);
+                    break;
+                case CharacterKind::Archer:
+                    attackWith(static_cast<Archer&>(*attackerCharacter), targetId, weaponName);
+                    break;
+                default:
+                    out << "Error caught" << '\n';
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    // Burns the spell in slot of caster's book and kills the target. The spell goes first and
+    // the target last: the caster may be its own target, and nothing is held by a copy.
+    template<typename Caster>
+    void castFrom(Caster& caster, int spell, int targetId, string_view casterName, string_view targetName, string_view spellName) {
+        out << casterName << " casts " << spellName << " on " << targetName << "!" << '\n';
+        caster.book.erase(spell);
+        characters.erase(targetId);
+        out << targetName << " has died..." << '\n';
+    }
+
+    void performCast(string_view casterName, string_view targetName, string_view spellName) {
+        int targetId = symbols.find(targetName);
+        const auto& casterCharacter = findCharacter(casterName);
+        const auto& targetCharacter = characters.get(targetId);
+        if (casterCharacter && targetCharacter) {
+            int spellId = symbols.find(spellName);
+            switch (casterCharacter->kind) {
+                case CharacterKind::Wizard: {
+                    auto& wizard = static_cast<Wizard&>(*casterCharacter);
+                    int spell = wizard.book.find(spellId);
+                    if (spell >= 0) {
+                        castFrom(wizard, spell, targetId, casterName, targetName, spellName);
+                    } else {
+                        out << "Error caught" << '\n';
+                    }
+                    break;
+                }
+                case CharacterKind::Archer: {
+                    auto& archer = static_cast<Archer&>(*casterCharacter);
+                    int spell = archer.book.find(spellId);
+                    if (spell >= 0) {
+                        const auto& owners = archer.book.at(spell)->owners;
+                        if (find(owners.begin(), owners.end(), targetCharacter) != owners.end()) {
+                            castFrom(archer, spell, targetId, casterName, targetName, spellName);
+                        } else {
+                            out << "Error caught" << '\n';
+                        }
+                    } else {
+                        out << "Error caught" << '\n';
+                    }
+                    break;
+                }
+                default:
+                    out << "Error caught" << '\n';
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    // Drinker drinks a potion out of supplier's medical bag (Fighter or Wizard)
+    template<typename Supplier>
+    void drinkFrom(Supplier& supplier, Character& drinker, string_view potionName) {
+        if (supplier.bag.size() > 0) {
+            int potion = supplier.bag.find(symbols.find(potionName));
+            if (potion >= 0) {
+                drinker.hp += supplier.bag.at(potion)->healthAffectValue;
+                supplier.bag.erase(potion);
+            } else {
+                out << "Error caught" << '\n';
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    void performDrink(string_view supplierName, string_view drinkerName, string_view potionName) {
+        const auto& supplier = findCharacter(supplierName);
+        const auto& drinker = findCharacter(drinkerName);
+        if (supplier && drinker) {
+            out << drinkerName << " drinks " << potionName << " from " << supplierName << "." << '\n';
+            switch (supplier->kind) {
+                case CharacterKind::Fighter:
+                    drinkFrom(static_cast<Fighter&>(*supplier), *drinker, potionName);
+                    break;
+                case CharacterKind::Wizard:
+                    drinkFrom(static_cast<Wizard&>(*supplier), *drinker, potionName);
+                    break;
+                default:
+                    out << "Error caught" << '\n';
+            }
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+    // Prints the sp_len words of speech, each followed by a space; the last one runs to the end of the line
+    void printSpeech(int sp_len, string_view speech) {
+        for (int j = 0; j < sp_len; ++j) {
+            out << (j == sp_len - 1 ? speech : nextField(speech)) << " ";
+        }
+    }
+
+    void performDialogue(string_view speaker, int sp_len, string_view speech) {
+        if (speaker == narrator.name) {
+            out << narrator.name << ": ";
+            printSpeech(sp_len, speech);
+            out << '\n';
+        }
+        else {
+            const auto& character = findCharacter(speaker);
+            if (character) {
+                out << character->name << ": ";
+                printSpeech(sp_len, speech);
+                out << '\n';
+            }
+            else {
+                out << "Error caught" << '\n';
+            }
+        }
+    }
+    void showCharacters() {
+        characters.forEachSorted(symbols, [&](const shared_ptr<Character>& character) {
+            out << character->name << ":" << kindName(character->kind) << ":" << character->hp << " ";
+        });
+        out << '\n';
+    }
+
+    void showItems(string_view itemType, string_view characterName) {
+        if (const auto& character = findCharacter(characterName)) {
+            character->show(out, itemType); // show is virtual; every kind in the map overrides it
+        } else {
+            out << "Error caught" << '\n';
+        }
+    }
+
+
+    // Runs one parsed script line
+    void execute(const Command& command) {
+        switch (command.type) {
+            case CommandType::CreateCharacter:
+                createCharacter(command.kind, command.actor, command.value);
+                break;
+            case CommandType::CreateItem:
+                createItem(command.kind, command.actor, command.item, command.value, command.rest);
+                break;
+            case CommandType::Attack:
+                performAttack(command.actor, command.target, command.item);
+                break;
+            case CommandType::Cast:
+                performCast(command.actor, command.target, command.item);
+                break;
+            case CommandType::Drink:
+                performDrink(command.actor, command.target, command.item);
+                break;
+            case CommandType::Dialogue:
+                performDialogue(command.actor, command.value, command.rest);
+                break;
+            case CommandType::ShowCharacters:
+                showCharacters();
+                break;
+            case CommandType::ShowItems:
+                showItems(command.kind, command.actor);
+                break;
+            case CommandType::Unknown:
+                break;
+        }
+    }
+
+    // A script declares 1..2000 events; the events still run when it doesn't
+    void checkEventCount(int n) {
+        if (n < 1 || n > 2000){out << "Error caught" << '\n';}
+    }
+
+    // Reads the event count and then that many lines, each parsed in place in the input buffer
+    void processCommands(FastInput& in) {
+        int n = in.readInt();
+        checkEventCount(n);
+        in.readLine(); // Rest of the count line
+        for (int i = 0; i < n; ++i) {
+            execute(parseCommand(in.readLine()));
+        }
+    }
+};
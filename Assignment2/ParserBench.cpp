@@ -0,0 +1,185 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include "../Common/FastInput.h"
+#include "CommandParser.h"
+#include "ScriptGenerator.h"
+
+using namespace std;
+
+// Benchmark: parsed commands per second for the old getline/substr command splitting and
+// for parseCommand over a memory-mapped script. No command is executed; both parsers
+// fold the fields they extract into a checksum, and the two checksums must agree.
+// Usage: ParserBench [commands].
+
+// Order-sensitive digest of the fields of one command
+struct Checksum {
+    unsigned long long value = 0;
+    void add(string_view field) {
+        for (char c : field) {
+            value = value * 131 + (unsigned char)c;
+        }
+        value = value * 131 + 1;
+    }
+    void add(int number) {
+        value = value * 131 + (unsigned)number;
+    }
+};
+
+// The pre-parseCommand splitting from Game::processCommands, field for field
+unsigned long long parseLegacy(istream& in) {
+    Checksum sum;
+    int n;
+    in >> n;
+    in.ignore();
+    for (int i = 0; i < n; ++i) {
+        string command;
+        getline(in, command);
+        string commandType = command.substr(0, command.find(" "));
+        if (commandType == "Create") {
+            if (command.find("character") != string::npos) {
+                string characterType = command.substr(command.find("character") + 10, command.find(" ", command.find("character") + 10) - command.find("character") - 10);
+                string rest = command.substr(command.find(" ", command.find("character") + 10) + 1);
+                string name = rest.substr(0, rest.find(" "));
+                rest = rest.substr(rest.find(" ") + 1);
+                int initHP = stoi(rest.substr(0, rest.find(" ")));
+                sum.add(characterType), sum.add(name), sum.add(initHP);
+            } else {
+                string itemType = command.substr(command.find("item") + 5, command.find(" ", command.find("item") + 5) - command.find("item") - 5);
+                string rest = command.substr(command.find(" ", command.find("item") + 5) + 1);
+                string ownerName = rest.substr(0, rest.find(" "));
+                rest = rest.substr(rest.find(" ") + 1);
+                string itemName = rest.substr(0, rest.find(" "));
+                rest = rest.substr(rest.find(" ") + 1);
+                int value = stoi(rest.substr(0, rest.find(" ")));
+                sum.add(itemType), sum.add(ownerName), sum.add(itemName), sum.add(value);
+                if (itemType == "spell") {
+                    rest = rest.substr(rest.find("[") + 1);
+                    string targetCharactersString = rest.substr(0, rest.find("]"));
+                    vector<string> targetCharacters;
+                    size_t pos = 0;
+                    string token;
+                    while ((pos = targetCharactersString.find(", ")) != string::npos) {
+                        token = targetCharactersString.substr(0, pos);
+                        targetCharacters.push_back(token);
+                        targetCharactersString.erase(0, pos + 2);
+                    }
+                    targetCharacters.push_back(targetCharactersString);
+                    for (const auto& target : targetCharacters) {
+                        sum.add(target);
+                    }
+                }
+            }
+        } else if (commandType == "Attack" || commandType == "Cast" || commandType == "Drink") {
+            string actor = command.substr(command.find(" ") + 1, command.find(" ", command.find(" ") + 1) - command.find(" ") - 1);
+            string rest = command.substr(command.find(" ", command.find(" ") + 1) + 1);
+            string target = rest.substr(0, rest.find(" "));
+            rest = rest.substr(rest.find(" ") + 1);
+            sum.add(actor), sum.add(target), sum.add(rest);
+        } else if (commandType == "Dialogue") {
+            string speaker = command.substr(command.find(" ") + 1, command.find(" ", command.find(" ") + 1) - command.find(" ") - 1);
+            string rest = command.substr(command.find(" ", command.find(" ") + 1) + 1);
+            int sp_len = stoi(rest.substr(0, rest.find(" ")));
+            rest = rest.substr(rest.find(" ") + 1);
+            vector<string> speech;
+            for (int j = 0; j < sp_len; ++j) {
+                if (j == sp_len - 1) {
+                    speech.push_back(rest);
+                } else {
+                    speech.push_back(rest.substr(0, rest.find(" ")));
+                    rest = rest.substr(rest.find(" ") + 1);
+                }
+            }
+            sum.add(speaker), sum.add(sp_len);
+            for (const auto& word : speech) {
+                sum.add(word);
+            }
+        } else if (commandType == "Show") {
+            if (command.find("characters") != string::npos) {
+                sum.add(0);
+            } else {
+                string itemType = command.substr(command.find("items") + 6, command.find(" ", command.find("items") + 6) - command.find("items") - 6);
+                string characterName = command.substr(command.find(" ", command.find("items") + 6) + 1);
+                sum.add(itemType), sum.add(characterName);
+            }
+        }
+    }
+    return sum.value;
+}
+
+// parseCommand over the mapped input, folding the same fields in the same order
+unsigned long long parseInPlace(FastInput& in) {
+    Checksum sum;
+    int n = in.readInt();
+    in.readLine();
+    for (int i = 0; i < n; ++i) {
+        Command command = parseCommand(in.readLine());
+        switch (command.type) {
+            case CommandType::CreateCharacter:
+                sum.add(command.kind), sum.add(command.actor), sum.add(command.value);
+                break;
+            case CommandType::CreateItem:
+                sum.add(command.kind), sum.add(command.actor), sum.add(command.item), sum.add(command.value);
+                if (command.kind == "spell") {
+                    forEachListed(command.rest, [&](string_view target) { sum.add(target); });
+                }
+                break;
+            case CommandType::Attack:
+            case CommandType::Cast:
+            case CommandType::Drink:
+                sum.add(command.actor), sum.add(command.target), sum.add(command.item);
+                break;
+            case CommandType::Dialogue: {
+                sum.add(command.actor), sum.add(command.value);
+                string_view speech = command.rest;
+                for (int j = 0; j < command.value; ++j) {
+                    sum.add(j == command.value - 1 ? speech : nextField(speech));
+                }
+                break;
+            }
+            case CommandType::ShowCharacters:
+                sum.add(0);
+                break;
+            case CommandType::ShowItems:
+                sum.add(command.kind), sum.add(command.actor);
+                break;
+            case CommandType::Unknown:
+                break;
+        }
+    }
+    return sum.value;
+}
+
+int main(int argc, char* argv[]) {
+    int commands = argc > 1 ? stoi(argv[1]) : 1000000;
+    string script = generateScript(commands, 7);
+    FILE* file = scriptFile(script);
+    if (!file) {
+        cerr << "Error: Unable to create the script file." << endl;
+        return 1;
+    }
+
+    istringstream legacyInput(script);
+    auto start = chrono::steady_clock::now();
+    unsigned long long legacySum = parseLegacy(legacyInput);
+    double legacySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    unsigned long long inPlaceSum;
+    {
+        FastInput in(fileno(file));
+        inPlaceSum = parseInPlace(in);
+    }
+    double inPlaceSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    fclose(file);
+
+    cout << "commands: " << commands << fixed << setprecision(0) << endl;
+    cout << "getline + substr   " << setw(12) << commands / legacySeconds << " commands/s" << endl;
+    cout << "parseCommand       " << setw(12) << commands / inPlaceSeconds << " commands/s"
+         << (legacySum == inPlaceSum ? "" : "   MISMATCH") << endl;
+    return 0;
+}
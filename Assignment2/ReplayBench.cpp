@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include "Game.h"
+#include "ScriptGenerator.h"
+
+using namespace std;
+
+// Benchmark: replays a large generated command script through Game, and times the old
+// dynamic_pointer_cast chain against the CharacterKind switch that replaced it.
+// Usage: ReplayBench [commands]. Game output goes to /dev/null.
+
+// The dispatch performAttack and friends used to do: up to three RTTI casts per command
+int castChain(const shared_ptr<Character>& character) {
+    if (auto fighter = dynamic_pointer_cast<Fighter>(character)) {
+        return fighter->arsenal.size();
+    } else if (auto wizard = dynamic_pointer_cast<Wizard>(character)) {
+        return wizard->book.size();
+    } else if (auto archer = dynamic_pointer_cast<Archer>(character)) {
+        return archer->arsenal.size() + archer->book.size();
+    }
+    return -1;
+}
+
+// The same dispatch through the kind tag
+int kindSwitch(const shared_ptr<Character>& character) {
+    switch (character->kind) {
+        case CharacterKind::Fighter:
+            return static_cast<Fighter&>(*character).arsenal.size();
+        case CharacterKind::Wizard:
+            return static_cast<Wizard&>(*character).book.size();
+        case CharacterKind::Archer: {
+            auto& archer = static_cast<Archer&>(*character);
+            return archer.arsenal.size() + archer.book.size();
+        }
+        default:
+            return -1;
+    }
+}
+
+template<typename Dispatch>
+double timeDispatch(const vector<shared_ptr<Character>>& population, int rounds, Dispatch dispatch, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& character : population) {
+            checksum += dispatch(character);
+        }
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int commands = argc > 1 ? stoi(argv[1]) : 1000000;
+    string script = generateScript(commands, 7);
+
+    FILE* input = scriptFile(script);
+    FILE* sink = fopen("/dev/null", "w");
+    if (!input || !sink) {
+        cerr << "Error: Unable to open the script or /dev/null." << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    {
+        FastInput in(fileno(input));
+        FastOutput out(sink);
+        Game game(out);
+        game.processCommands(in);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    fclose(input);
+    cout << "replay: " << commands << " commands in " << seconds * 1e3 << " ms ("
+         << fixed << setprecision(0) << commands / seconds << " commands/s)" << endl;
+
+    // Dispatch alone, over a mixed population
+    FastOutput out(sink); // Never written to; Game just needs a sink
+    Game game(out);
+    vector<shared_ptr<Character>> population;
+    mt19937 rng(11);
+    for (int i = 0; i < 4096; ++i) {
+        switch (rng() % 3) {
+            case 0: population.push_back(game.spawn<Fighter>()); break;
+            case 1: population.push_back(game.spawn<Wizard>()); break;
+            default: population.push_back(game.spawn<Archer>()); break;
+        }
+    }
+    const int rounds = 2000;
+    long long castSum = 0, switchSum = 0;
+    double castSeconds = timeDispatch(population, rounds, castChain, castSum);
+    double switchSeconds = timeDispatch(population, rounds, kindSwitch, switchSum);
+    double calls = double(rounds) * population.size();
+    cout << setprecision(2)
+         << "dispatch: cast chain " << castSeconds * 1e9 / calls << " ns/call"
+         << "   kind switch " << switchSeconds * 1e9 / calls << " ns/call"
+         << (castSum == switchSum ? "" : "   MISMATCH") << endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// Random but well-formed Assignment2 scripts for the benchmarks: a few hundred recurring
+// character and item names, so commands keep hitting (and missing) live entities.
+
+// Lower-case name for id, as the input format requires
+inline string entityName(const string& prefix, int id) {
+    string name = prefix;
+    do {
+        name += char('a' + id % 26);
+        id /= 26;
+    } while (id);
+    return name;
+}
+
+// The event count line followed by that many random commands
+inline string generateScript(int commands, unsigned seed) {
+    mt19937 rng(seed);
+    const int people = 200, things = 400;
+    const char* kinds[] = {"fighter", "wizard", "archer"};
+    const char* itemTypes[] = {"weapon", "potion", "spell"};
+    const char* shows[] = {"weapons", "potions", "spells"};
+    auto person = [&] { return entityName("c", rng() % people); };
+    auto thing = [&] { return entityName("i", rng() % things); };
+
+    ostringstream script;
+    script << commands << '\n';
+    for (int i = 0; i < commands; ++i) {
+        int roll = i < people ? 0 : rng() % 100;
+        if (roll < 10) {
+            script << "Create character " << kinds[rng() % 3] << ' ' << person() << ' ' << 1 + rng() % 200 << '\n';
+        } else if (roll < 35) {
+            int type = rng() % 3;
+            script << "Create item " << itemTypes[type] << ' ' << person() << ' ' << thing() << ' ' << 1 + rng() % 50;
+            if (type == 2) {
+                // Both target list forms: "[a, b]" and the bracket-less "a, b" of the task's samples
+                int targets = 1 + rng() % 3;
+                bool bracketed = rng() % 2;
+                script << (bracketed ? " [" : " ");
+                for (int j = 0; j < targets; ++j) {
+                    script << (j ? ", " : "") << person();
+                }
+                script << (bracketed ? "]" : "");
+            }
+            script << '\n';
+        } else if (roll < 60) {
+            script << "Attack " << person() << ' ' << person() << ' ' << thing() << '\n';
+        } else if (roll < 70) {
+            script << "Cast " << person() << ' ' << person() << ' ' << thing() << '\n';
+        } else if (roll < 85) {
+            script << "Drink " << person() << ' ' << person() << ' ' << thing() << '\n';
+        } else if (roll < 92) {
+            script << "Dialogue " << person() << " 3 " << thing() << ' ' << thing() << ' ' << thing() << '\n';
+        } else if (roll < 97) {
+            script << "Show " << shows[rng() % 3] << ' ' << person() << '\n';
+        } else {
+            script << "Show characters\n";
+        }
+    }
+    return script.str();
+}
+
+// Anonymous temporary file holding script, rewound so FastInput maps it from the start
+inline FILE* scriptFile(const string& script) {
+    FILE* file = tmpfile();
+    if (file) {
+        fwrite(script.data(), 1, script.size(), file);
+        fflush(file);
+        rewind(file);
+    }
+    return file;
+}
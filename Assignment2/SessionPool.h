@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a fixed set of independent tasks on a small work-stealing pool. Tasks are dealt
+// round-robin onto one deque per worker; a worker takes from the back of its own deque and,
+// once that is empty, steals from the front of the others', so a few long sessions don't
+// leave the rest of the threads idle. No task is added after the start, so a worker that
+// finds every deque empty is done.
+class SessionPool {
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    static bool take(Queue& queue, bool own, size_t& task) {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        if (own) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+
+public:
+    // Calls run(i) for every i in [0, count) on up to threads threads; returns when all are done
+    static void runAll(size_t count, unsigned threads, const std::function<void(size_t)>& run) {
+        if (count == 0) {
+            return;
+        }
+        threads = (unsigned)std::clamp<size_t>(threads, 1, count);
+        std::vector<Queue> queues(threads);
+        for (size_t i = 0; i < count; ++i) {
+            queues[i % threads].tasks.push_back(i);
+        }
+
+        auto worker = [&](unsigned self) {
+            size_t task;
+            for (;;) {
+                bool found = take(queues[self], true, task);
+                for (unsigned k = 1; !found && k < threads; ++k) {
+                    found = take(queues[(self + k) % threads], false, task);
+                }
+                if (!found) {
+                    return;
+                }
+                run(task);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+};
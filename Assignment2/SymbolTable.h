@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Interns names as dense integer ids (0, 1, 2, ... in first-seen order). Lookups hash the
+// name once into an open-addressing table of ids; everything after that compares ints.
+class SymbolTable {
+private:
+    std::vector<std::string> names; // By id
+    std::vector<uint32_t> hashes;   // By id, so growing never rehashes strings
+    std::vector<int> slots;         // Ids, -1 marks an empty slot; power of two, at most half full
+
+    static uint32_t hash(std::string_view name) {
+        uint32_t h = 2166136261u; // FNV-1a
+        for (char c : name) {
+            h = (h ^ (unsigned char)c) * 16777619u;
+        }
+        return h;
+    }
+
+    // Slot holding name, or the empty slot where it would go
+    size_t slotOf(std::string_view name, uint32_t h) const {
+        size_t mask = slots.size() - 1;
+        size_t i = h & mask;
+        while (slots[i] >= 0 && (hashes[slots[i]] != h || names[slots[i]] != name)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow() {
+        std::vector<int> old(slots.size() * 2, -1);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (int id = 0; id < (int)names.size(); ++id) {
+            size_t i = hashes[id] & mask;
+            while (slots[i] >= 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = id;
+        }
+    }
+
+public:
+    SymbolTable() : slots(64, -1) {}
+
+    // Id of name, or -1 if it was never interned
+    int find(std::string_view name) const {
+        return slots[slotOf(name, hash(name))];
+    }
+
+    // Id of name, assigning the next one on first sight
+    int intern(std::string_view name) {
+        uint32_t h = hash(name);
+        size_t i = slotOf(name, h);
+        if (slots[i] >= 0) {
+            return slots[i];
+        }
+        int id = (int)names.size();
+        names.emplace_back(name);
+        hashes.push_back(h);
+        slots[i] = id;
+        if (names.size() * 2 > slots.size()) {
+            grow();
+        }
+        return id;
+    }
+
+    const std::string& name(int id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+};
+
+// Symbol id -> shared_ptr<T>, stored densely by id. Iteration in name order goes through a
+// sorted view of the ids that is only re-sorted after new names have been added.
+template<typename T>
+class SymbolMap {
+private:
+    std::vector<std::shared_ptr<T>> slots; // By id; empty when absent
+    std::vector<int> sorted;               // Ids in name order; may still list erased ones
+    std::vector<char> listed;              // By id: whether it is in sorted
+    bool stale = false;                    // Ids were appended to sorted since the last sort
+
+public:
+    // Entry for id, empty if absent; no reference count is touched
+    const std::shared_ptr<T>& get(int id) const {
+        static const std::shared_ptr<T> none;
+        return id >= 0 && id < (int)slots.size() ? slots[id] : none;
+    }
+
+    void set(int id, std::shared_ptr<T> value) {
+        if (id >= (int)slots.size()) {
+            slots.resize(id + 1);
+            listed.resize(id + 1);
+        }
+        slots[id] = std::move(value);
+        if (!listed[id]) {
+            listed[id] = 1;
+            sorted.push_back(id);
+            stale = true;
+        }
+    }
+
+    void erase(int id) {
+        if (id >= 0 && id < (int)slots.size()) {
+            slots[id].reset();
+        }
+    }
+
+    // Visits the present entries in ascending name order
+    template<typename Visitor>
+    void forEachSorted(const SymbolTable& symbols, Visitor visit) {
+        if (stale) {
+            // Drop erased ids while re-sorting, so the view never outgrows the live set for long
+            auto live = std::remove_if(sorted.begin(), sorted.end(), [&](int id) {
+                if (slots[id]) {
+                    return false;
+                }
+                listed[id] = 0;
+                return true;
+            });
+            sorted.erase(live, sorted.end());
+            std::sort(sorted.begin(), sorted.end(), [&](int a, int b) { return symbols.name(a) < symbols.name(b); });
+            stale = false;
+        }
+        for (int id : sorted) {
+            if (slots[id]) {
+                visit(slots[id]);
+            }
+        }
+    }
+};
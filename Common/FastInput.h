@@ -0,0 +1,151 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FAST_INPUT_POSIX 1
+#endif
+
+// Whole-input reader that parses tokens in place: regular files are memory-mapped,
+// pipes and terminals are slurped in large blocks. Tokens are views into the buffer.
+class FastInput {
+private:
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    std::vector<char> buffer; // Backing storage when the input can't be mapped
+    void* mapped = nullptr;
+    size_t mappedSize = 0;
+
+    static constexpr size_t blockSize = 1 << 20;
+
+    void readBlocks(int fd) {
+        size_t used = 0;
+        for (;;) {
+            buffer.resize(used + blockSize);
+#ifdef FAST_INPUT_POSIX
+            ssize_t got = ::read(fd, buffer.data() + used, blockSize);
+#else
+            size_t got = std::fread(buffer.data() + used, 1, blockSize, stdin);
+#endif
+            if (got <= 0) {
+                break;
+            }
+            used += got;
+        }
+        buffer.resize(used);
+        pos = buffer.data();
+        end = pos + used;
+    }
+
+public:
+    // Takes over the given descriptor (stdin by default) and loads it all
+    explicit FastInput(int fd = 0) {
+#ifdef FAST_INPUT_POSIX
+        struct stat st {};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            off_t offset = lseek(fd, 0, SEEK_CUR);
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                mapped = p;
+                mappedSize = st.st_size;
+                pos = static_cast<const char*>(p) + (offset > 0 ? offset : 0);
+                end = static_cast<const char*>(p) + st.st_size;
+                return;
+            }
+        }
+#endif
+        readBlocks(fd);
+    }
+
+    FastInput(const FastInput&) = delete;
+    FastInput& operator=(const FastInput&) = delete;
+
+    ~FastInput() {
+#ifdef FAST_INPUT_POSIX
+        if (mapped) {
+            munmap(mapped, mappedSize);
+        }
+#endif
+    }
+
+    // Skips whitespace; returns false once the input is exhausted
+    bool skipSpace() {
+        while (pos < end && static_cast<unsigned char>(*pos) <= ' ') {
+            ++pos;
+        }
+        return pos < end;
+    }
+
+    // Next whitespace-delimited token, empty at end of input
+    std::string_view readToken() {
+        skipSpace();
+        const char* start = pos;
+        while (pos < end && static_cast<unsigned char>(*pos) > ' ') {
+            ++pos;
+        }
+        return std::string_view(start, pos - start);
+    }
+
+    // Everything not yet consumed, e.g. for binary formats that decode the buffer themselves
+    std::string_view remaining() const {
+        return std::string_view(pos, end - pos);
+    }
+
+    // Rest of the current line without its '\n'; moves to the start of the next line
+    std::string_view readLine() {
+        const char* start = pos;
+        while (pos < end && *pos != '\n') {
+            ++pos;
+        }
+        std::string_view line(start, pos - start);
+        if (pos < end) {
+            ++pos;
+        }
+        return line;
+    }
+
+    // Next signed decimal integer, parsed without any intermediate string
+    long long readLong() {
+        skipSpace();
+        bool negative = false;
+        if (pos < end && (*pos == '-' || *pos == '+')) {
+            negative = *pos == '-';
+            ++pos;
+        }
+        unsigned long long value = 0;
+        while (pos < end && static_cast<unsigned>(*pos - '0') < 10) {
+            value = value * 10 + (*pos - '0');
+            ++pos;
+        }
+        return negative ? -static_cast<long long>(value) : static_cast<long long>(value);
+    }
+
+    int readInt() {
+        return static_cast<int>(readLong());
+    }
+
+    // Next decimal floating-point value of type T, correctly rounded like operator>>
+    template<typename T>
+    T readReal() {
+        skipSpace();
+        if (pos < end && *pos == '+') {
+            ++pos;
+        }
+        T value = 0;
+        auto result = std::from_chars(pos, end, value);
+        pos = result.ptr;
+        return value;
+    }
+
+    double readDouble() {
+        return readReal<double>();
+    }
+};
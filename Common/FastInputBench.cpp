@@ -0,0 +1,105 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include "FastInput.h"
+
+using namespace std;
+
+// Benchmark: parse a TaskA-style command file with the old cin path and with FastInput.
+// Usage: FastInputBench [ops] [file]; without a file a random script is generated.
+
+// Writes "n m", n array values and m sum/set commands to path
+void generateScript(const string& path, int n, int m) {
+    ofstream out(path);
+    mt19937 rng(42);
+    out << n << " " << m << "\n";
+    for (int i = 0; i < n; ++i) {
+        out << (int)(rng() % 100) - 50 << " ";
+    }
+    out << "\n";
+    for (int i = 0; i < m; ++i) {
+        int a = rng() % n;
+        int b = a + rng() % (n - a);
+        if (rng() % 2) {
+            out << "sum " << a << " " << b << "\n";
+        } else {
+            out << "set " << a << " " << (int)(rng() % 100) - 50 << "\n";
+        }
+    }
+}
+
+// The pre-FastInput path: cin >> string for each op, then cin >> int per field
+long long parseWithCin(const string& path) {
+    if (!freopen(path.c_str(), "r", stdin)) {
+        return -1;
+    }
+    cin.clear();
+    long long checksum = 0;
+    int n, m;
+    cin >> n >> m;
+    for (int i = 0; i < n; ++i) {
+        int x;
+        cin >> x;
+        checksum += x;
+    }
+    for (int i = 0; i < m; ++i) {
+        string op;
+        int a, b;
+        cin >> op >> a >> b;
+        checksum += (op == "sum" ? 1 : 2) + a + b;
+    }
+    return checksum;
+}
+
+// The FastInput path: in-place tokens and a byte switch on the opcode
+long long parseWithFastInput(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    long long checksum = 0;
+    {
+        FastInput in(fd);
+        int n = in.readInt();
+        int m = in.readInt();
+        for (int i = 0; i < n; ++i) {
+            checksum += in.readInt();
+        }
+        for (int i = 0; i < m; ++i) {
+            string_view op = in.readToken();
+            int a = in.readInt();
+            int b = in.readInt();
+            checksum += (op[1] == 'u' ? 1 : 2) + a + b;
+        }
+    }
+    close(fd);
+    return checksum;
+}
+
+template<typename F>
+void timeRun(const string& label, F parse, const string& path, int ops) {
+    auto start = chrono::steady_clock::now();
+    long long checksum = parse(path);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cerr << label << ": " << seconds << " s, " << (long long)(ops / seconds) << " ops/s (checksum " << checksum << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int ops = argc > 1 ? stoi(argv[1]) : 2000000;
+    string path = argc > 2 ? argv[2] : "fast_input_bench.txt";
+    if (argc <= 2) {
+        generateScript(path, ops, ops);
+    }
+
+    timeRun("cin      ", parseWithCin, path, ops);
+    timeRun("FastInput", parseWithFastInput, path, ops);
+
+    if (argc <= 2) {
+        remove(path.c_str());
+    }
+    return 0;
+}
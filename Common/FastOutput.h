@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Buffered writer for result streams: formats integers and fixed-point values by hand
+// into one large buffer and hands it to the FILE only when full or on flush/destruction.
+class FastOutput {
+private:
+    FILE* file;
+    std::vector<char> buffer;
+    size_t used = 0;
+
+    static constexpr size_t defaultCapacity = 1 << 20;
+
+    void reserve(size_t bytes) {
+        if (used + bytes > buffer.size()) {
+            flush();
+            if (bytes > buffer.size()) {
+                buffer.resize(bytes);
+            }
+        }
+    }
+
+    // Writes the decimal digits of value (no sign) and returns the digit count
+    static int formatUnsigned(char* out, unsigned long long value) {
+        char digits[20];
+        int len = 0;
+        do {
+            digits[len++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        for (int i = 0; i < len; ++i) {
+            out[i] = digits[len - 1 - i];
+        }
+        return len;
+    }
+
+    // Rounds |value| * 10^precision to the nearest integer exactly like printf("%.*f"):
+    // ties (judged on the exact binary value via fma) go to the even neighbour.
+    // Returns false when the scaled value is too large for this fast path.
+    static bool scaleAndRound(double value, int precision, unsigned long long& result) {
+        double factor = 1;
+        for (int i = 0; i < precision; ++i) {
+            factor *= 10;
+        }
+        double scaled = value * factor;
+        if (!(scaled < 4503599627370496.0)) { // 2^52: past this floor/fma tricks lose exactness
+            return false;
+        }
+        double error = std::fma(value, factor, -scaled); // exact: value * factor = scaled + error
+        double whole = std::floor(scaled);
+        double diff = (scaled - whole) - 0.5; // exact for |scaled| < 2^52
+        unsigned long long rounded = static_cast<unsigned long long>(whole);
+        if (diff > -error || (diff == -error && (rounded & 1))) {
+            ++rounded;
+        }
+        result = rounded;
+        return true;
+    }
+
+public:
+    explicit FastOutput(FILE* file = stdout, size_t capacity = defaultCapacity)
+        : file(file), buffer(capacity) {}
+
+    FastOutput(const FastOutput&) = delete;
+    FastOutput& operator=(const FastOutput&) = delete;
+
+    ~FastOutput() {
+        flush();
+    }
+
+    // Hands the buffered bytes to the FILE and flushes it
+    void flush() {
+        if (used) {
+            std::fwrite(buffer.data(), 1, used, file);
+            used = 0;
+        }
+        std::fflush(file);
+    }
+
+    void write(const char* data, size_t len) {
+        reserve(len);
+        std::memcpy(buffer.data() + used, data, len);
+        used += len;
+    }
+
+    FastOutput& operator<<(char c) {
+        reserve(1);
+        buffer[used++] = c;
+        return *this;
+    }
+
+    FastOutput& operator<<(std::string_view s) {
+        write(s.data(), s.size());
+        return *this;
+    }
+
+    FastOutput& operator<<(const char* s) {
+        return *this << std::string_view(s);
+    }
+
+    FastOutput& operator<<(const std::string& s) {
+        return *this << std::string_view(s);
+    }
+
+    FastOutput& operator<<(long long value) {
+        reserve(21);
+        unsigned long long magnitude = value;
+        if (value < 0) {
+            buffer[used++] = '-';
+            magnitude = 0 - magnitude;
+        }
+        used += formatUnsigned(buffer.data() + used, magnitude);
+        return *this;
+    }
+
+    FastOutput& operator<<(int value) {
+        return *this << static_cast<long long>(value);
+    }
+
+    FastOutput& operator<<(unsigned long long value) {
+        reserve(20);
+        used += formatUnsigned(buffer.data() + used, value);
+        return *this;
+    }
+
+    FastOutput& operator<<(size_t value) {
+        return *this << static_cast<unsigned long long>(value);
+    }
+
+    // Same bytes as printf("%.*f", precision, value) / fixed << setprecision(precision)
+    FastOutput& writeFixed(double value, int precision) {
+        unsigned long long scaled;
+        if (precision < 0 || precision > 15 || !std::isfinite(value) ||
+            !scaleAndRound(std::fabs(value), precision, scaled)) {
+            char tmp[512];
+            int len = std::snprintf(tmp, sizeof(tmp), "%.*f", precision, value);
+            write(tmp, len);
+            return *this;
+        }
+        reserve(24);
+        if (std::signbit(value)) {
+            buffer[used++] = '-';
+        }
+        unsigned long long divisor = 1;
+        for (int i = 0; i < precision; ++i) {
+            divisor *= 10;
+        }
+        used += formatUnsigned(buffer.data() + used, scaled / divisor);
+        if (precision > 0) {
+            buffer[used++] = '.';
+            unsigned long long frac = scaled % divisor;
+            for (int i = precision - 1; i >= 0; --i) {
+                buffer[used + i] = static_cast<char>('0' + frac % 10);
+                frac /= 10;
+            }
+            used += precision;
+        }
+        return *this;
+    }
+
+    // long double keeps its own printf path; rounding it to double first could change digits
+    FastOutput& writeFixed(long double value, int precision) {
+        char tmp[5120];
+        int len = std::snprintf(tmp, sizeof(tmp), "%.*Lf", precision, value);
+        write(tmp, std::min<size_t>(len, sizeof(tmp) - 1));
+        return *this;
+    }
+};